@@ -22,6 +22,7 @@
 
 
 #import <XCTest/XCTest.h>
+#import <stdatomic.h>
 
 @interface Helper : NSObject
 
@@ -227,6 +228,121 @@
     XCTAssert([expectedArray isEqualToArray:sortedArray], @"The array is not sorted as expected");
 }
 
+- (void)test_arraySortedByKey_withEqualKeys_keepsOrder {
+    NSArray *array = @[@{@"value": @2, @"name": @"a"}, @{@"value": @1, @"name": @"b"}, @{@"value": @2, @"name": @"c"}, @{@"value": @1, @"name": @"d"}];
+    NSArray *sortedArray = [array arraySortedByKey:@"value" ascending:YES];
+    NSArray *names = [sortedArray valueForKey:@"name"];
+    NSArray *expected = @[@"b", @"d", @"a", @"c"];
+    XCTAssertEqualObjects(names, expected, @"The array is not sorted as expected");
+
+    sortedArray = [array arraySortedByKey:@"value" ascending:NO];
+    names = [sortedArray valueForKey:@"name"];
+    expected = @[@"a", @"c", @"b", @"d"];
+    XCTAssertEqualObjects(names, expected, @"The array is not sorted as expected");
+}
+
+- (void)test_arraySortedByKey_withBooleanKeys_sortsLikeNumbers {
+    NSArray *array = @[@{@"value": @YES, @"name": @"a"}, @{@"value": @NO, @"name": @"b"}, @{@"value": @YES, @"name": @"c"}, @{@"value": @NO, @"name": @"d"}];
+    NSArray *sortedArray = [array arraySortedByKey:@"value" ascending:YES];
+    NSArray *names = [sortedArray valueForKey:@"name"];
+    NSArray *expected = @[@"b", @"d", @"a", @"c"];
+    XCTAssertEqualObjects(names, expected, @"The array is not sorted as expected");
+
+    array = @[@{@"value": @2, @"name": @"a"}, @{@"value": @YES, @"name": @"b"}, @{@"value": @(-1), @"name": @"c"}, @{@"value": @NO, @"name": @"d"}];
+    sortedArray = [array arraySortedByKey:@"value" ascending:NO];
+    names = [sortedArray valueForKey:@"name"];
+    expected = @[@"a", @"b", @"d", @"c"];
+    XCTAssertEqualObjects(names, expected, @"The array is not sorted as expected");
+}
+
+- (void)test_arraySortedWithDescriptors_onRandomKeys_sortsLikeSortDescriptors {
+    srand48(25);
+    NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:0];
+    // large enough for the concurrent merge sort
+    for (NSNumber *count in @[@10, @1000, @70000]) {
+        NSMutableArray *array = [NSMutableArray arrayWithCapacity:count.unsignedIntegerValue];
+        for (NSUInteger index = 0; index < count.unsignedIntegerValue; index++) {
+            [array addObject:@{@"integer": @(lrand48() % 100 - 50),
+                               @"double": @((drand48() - 0.5) * 1e6),
+                               @"mixed": index % 2 == 0 ? @(lrand48() % 10) : @(drand48() * 10),
+                               @"date": [date dateByAddingTimeInterval:lrand48() % 1000 - 500],
+                               @"string": [NSString stringWithFormat:@"%c%ld", (char)('a' + lrand48() % 26), lrand48() % 10],
+                               @"index": @(index)}];
+        }
+        for (NSString *key in @[@"integer", @"double", @"mixed", @"date", @"string"]) {
+            for (NSNumber *ascending in @[@YES, @NO]) {
+                // the index makes the expected order stable
+                NSArray *descriptors = @[[NSSortDescriptor sortDescriptorWithKey:key ascending:ascending.boolValue], [NSSortDescriptor sortDescriptorWithKey:@"index" ascending:YES]];
+                NSArray *expected = [array sortedArrayUsingDescriptors:descriptors];
+                NSArray *result = [array arraySortedByKey:key ascending:ascending.boolValue];
+                XCTAssertEqualObjects(result, expected, @"The array of %@ elements is not sorted as expected by %@", count, key);
+            }
+        }
+        NSArray *descriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"string" ascending:YES], [NSSortDescriptor sortDescriptorWithKey:@"integer" ascending:NO],
+                                 [NSSortDescriptor sortDescriptorWithKey:@"index" ascending:YES]];
+        XCTAssertEqualObjects([array arraySortedWithDescriptors:descriptors], [array sortedArrayUsingDescriptors:descriptors], @"The array is not sorted as expected by several keys");
+        descriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"string" ascending:NO selector:@selector(caseInsensitiveCompare:)], [NSSortDescriptor sortDescriptorWithKey:@"index" ascending:YES]];
+        XCTAssertEqualObjects([array arraySortedWithDescriptors:descriptors], [array sortedArrayUsingDescriptors:descriptors], @"The array is not sorted as expected with a selector");
+    }
+}
+
+- (void)test_arraySortedByKeys_sortsByLaterKeysOnEqualKeys {
+    NSArray *array = @[@{@"last": @"B", @"first": @"a"}, @{@"last": @"A", @"first": @"b"}, @{@"last": @"A", @"first": @"a"}];
+    NSArray *sortedArray = [array arraySortedByKeys:@[@"last", @"first"] ascending:YES];
+    NSArray *expected = @[array[2], array[1], array[0]];
+    XCTAssertEqualObjects(sortedArray, expected, @"The array is not sorted as expected");
+}
+
+- (void)test_performance_arraySortedByKey {
+    NSUInteger count = 200000;
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [array addObject:[Helper helperWithValue:(NSInteger)(index * 7919 % count)]];
+    }
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSArray *expected = [array sortedArrayUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"value" ascending:YES]]];
+    CFAbsoluteTime descriptorTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSArray *result = [array arraySortedByKey:@"value" ascending:YES];
+    CFAbsoluteTime sortTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqualObjects(result, expected, @"The array is not sorted as expected");
+    NSLog(@"%lu elements, sortedArrayUsingDescriptors: %.3fs, arraySortedByKey:ascending: %.3fs", (unsigned long)count, descriptorTime, sortTime);
+}
+
+
+#pragma mark - arraySortedByVersionAscending:
+
+- (void)test_arraySortedByVersionAscending_onUnsortedArray_returnsSortedArray {
+    NSArray *originalArray = @[@"1.10", @"1.2", @"2", @"1.2.0.1", @"0.9"];
+    NSArray *sortedArray = [originalArray arraySortedByVersionAscending:YES];
+    NSArray *expectedArray = @[@"0.9", @"1.2", @"1.2.0.1", @"1.10", @"2"];
+    XCTAssert([expectedArray isEqualToArray:sortedArray], @"The array is not sorted as expected '%@'", sortedArray);
+
+    sortedArray = [originalArray arraySortedByVersionAscending:NO];
+    expectedArray = @[@"2", @"1.10", @"1.2.0.1", @"1.2", @"0.9"];
+    XCTAssert([expectedArray isEqualToArray:sortedArray], @"The array is not sorted as expected '%@'", sortedArray);
+}
+
+- (void)test_arraySortedByVersionAscending_withEqualAndInvalidVersions_keepsTheirOrder {
+    NSString *first = [NSMutableString stringWithString:@"1.2"];
+    NSString *second = [NSMutableString stringWithString:@"1.2.0"];
+    NSArray *originalArray = @[@"3", first, @"beta", second, @5, @"1.0"];
+    NSArray *sortedArray = [originalArray arraySortedByVersionAscending:YES];
+    NSArray *expectedArray = @[@"beta", @5, @"1.0", first, second, @"3"];
+    XCTAssert([expectedArray isEqualToArray:sortedArray], @"The array is not sorted as expected '%@'", sortedArray);
+    XCTAssert(sortedArray[3] == first && sortedArray[4] == second, @"Equal versions should keep their order");
+    XCTAssert([[@[] arraySortedByVersionAscending:YES] isEqualToArray:@[]], @"The array should be empty");
+}
+
+- (void)test_maximumVersion {
+    NSArray *array = @[@"1.10", @"1.2", @"beta", @"1.10.0", @"0.9"];
+    XCTAssertEqual([array maximumVersion], array[0], @"Result is not correct");
+    XCTAssertNil([@[@"beta", @"1.x"] maximumVersion], @"Result is not correct");
+    XCTAssertNil([@[] maximumVersion], @"Result is not correct");
+}
+
 
 #pragma mark - firstObjectPassingTest:
 
@@ -351,5 +467,306 @@
     XCTAssertEqual(result.count, 0, @"The result array should be empty");
 }
 
+- (void)test_arrayWithRandomElementsChosen_withSeededSource_returnsDistinctElementsInOrder {
+    NSMutableArray *array = [NSMutableArray array];
+    for (NSInteger index = 0; index < 1000; index++) {
+        [array addObject:@(index)];
+    }
+    INSeededRandom *random = [INSeededRandom randomWithSeed:22];
+    // few elements are drawn with Floyd's algorithm, many by selection sampling
+    for (NSNumber *count in @[@1, @10, @249, @250, @251, @999]) {
+        NSArray *result = [array arrayWithRandomElementsChosen:count.unsignedIntegerValue preservingOrder:YES usingRandomSource:random];
+        XCTAssertEqual(result.count, count.unsignedIntegerValue, @"The result array should have %@ elements", count);
+        XCTAssertEqual([NSSet setWithArray:result].count, result.count, @"The result should not contain duplicates");
+        XCTAssertEqualObjects([result sortedArrayUsingSelector:@selector(compare:)], result, @"The order should be unchanged");
+
+        NSArray *unordered = [array arrayWithRandomElementsChosen:count.unsignedIntegerValue preservingOrder:NO usingRandomSource:random];
+        XCTAssertEqual([NSSet setWithArray:unordered].count, count.unsignedIntegerValue, @"The result array should have %@ distinct elements", count);
+    }
+
+    NSArray *result = [array arrayWithRandomElementsChosen:10 preservingOrder:NO usingRandomSource:[INSeededRandom randomWithSeed:22]];
+    NSArray *other = [array arrayWithRandomElementsChosen:10 preservingOrder:NO usingRandomSource:[INSeededRandom randomWithSeed:22]];
+    XCTAssertEqualObjects(result, other, @"The same seed should return the same elements");
+
+    result = [array arrayWithRandomElementsRemoved:990 preservingOrder:YES usingRandomSource:random];
+    XCTAssertEqual(result.count, 10, @"The result array should have 10 elements");
+    XCTAssertEqualObjects([result sortedArrayUsingSelector:@selector(compare:)], result, @"The order should be unchanged");
+}
+
+- (void)test_arrayWithRandomElementsChosen_withOneOfFour_returnsEachElementEqually {
+    NSArray *array = @[@0, @1, @2, @3];
+    INSeededRandom *random = [INSeededRandom randomWithSeed:4];
+    NSUInteger counts[4] = {0};
+    for (NSUInteger index = 0; index < 4000; index++) {
+        counts[[[array arrayWithRandomElementsChosen:1 preservingOrder:YES usingRandomSource:random][0] unsignedIntegerValue]]++;
+    }
+    for (NSUInteger index = 0; index < 4; index++) {
+        XCTAssert(counts[index] > 850 && counts[index] < 1150, @"The element %lu is chosen %lu times", (unsigned long)index, (unsigned long)counts[index]);
+    }
+}
+
+- (void)test_arrayWithRandomElementsChosenFromEnumeration_withEnumerator_returnsElementsInOrder {
+    NSMutableArray *array = [NSMutableArray array];
+    for (NSInteger index = 0; index < 1000; index++) {
+        [array addObject:@(index)];
+    }
+    INSeededRandom *random = [INSeededRandom randomWithSeed:22];
+    NSArray *result = [NSArray arrayWithRandomElementsChosen:20 fromEnumeration:[array objectEnumerator] preservingOrder:YES usingRandomSource:random];
+    XCTAssertEqual(result.count, 20, @"The result array should have 20 elements");
+    XCTAssertEqual([NSSet setWithArray:result].count, result.count, @"The result should not contain duplicates");
+    XCTAssertEqualObjects([result sortedArrayUsingSelector:@selector(compare:)], result, @"The order should be unchanged");
+
+    result = [NSArray arrayWithRandomElementsChosen:20 fromEnumeration:[array subarrayWithRange:NSMakeRange(0, 5)] preservingOrder:YES usingRandomSource:random];
+    XCTAssertEqualObjects(result, [array subarrayWithRange:NSMakeRange(0, 5)], @"All elements should be returned");
+
+    result = [NSArray arrayWithRandomElementsChosen:5 fromEnumeration:[NSSet setWithArray:array] preservingOrder:NO usingRandomSource:random];
+    XCTAssertEqual([NSSet setWithArray:result].count, 5, @"The result array should have 5 distinct elements");
+
+    NSUInteger counts[4] = {0};
+    for (NSUInteger index = 0; index < 4000; index++) {
+        NSArray *chosen = [NSArray arrayWithRandomElementsChosen:1 fromEnumeration:@[@0, @1, @2, @3] preservingOrder:YES usingRandomSource:random];
+        counts[[chosen[0] unsignedIntegerValue]]++;
+    }
+    for (NSUInteger index = 0; index < 4; index++) {
+        XCTAssert(counts[index] > 850 && counts[index] < 1150, @"The element %lu is chosen %lu times", (unsigned long)index, (unsigned long)counts[index]);
+    }
+}
+
+
+#pragma mark - shuffle
+
+- (void)test_arrayWithRandomizedOrderUsingRandomSource_withSeededSource_returnsSameOrder {
+    NSMutableArray *array = [NSMutableArray array];
+    for (NSInteger index = 0; index < 100; index++) {
+        [array addObject:@(index)];
+    }
+    NSArray *result = [array arrayWithRandomizedOrderUsingRandomSource:[INSeededRandom randomWithSeed:21]];
+    NSArray *other = [array arrayWithRandomizedOrderUsingRandomSource:[INSeededRandom randomWithSeed:21]];
+    XCTAssertEqualObjects(result, other, @"The same seed should return the same order");
+    XCTAssertNotEqualObjects(result, array, @"The order should be changed");
+    NSArray *sorted = [result sortedArrayUsingSelector:@selector(compare:)];
+    XCTAssertEqualObjects(sorted, array, @"The result should contain all elements once");
+
+    NSMutableArray *mutableArray = [array mutableCopy];
+    [mutableArray shuffleUsingRandomSource:[INSeededRandom randomWithSeed:21]];
+    XCTAssertEqualObjects(mutableArray, result, @"Shuffling in place should return the same order");
+}
+
+- (void)test_shuffle_withThreeElements_returnsAllPermutationsEqually {
+    INSeededRandom *random = [INSeededRandom randomWithSeed:3];
+    NSCountedSet *permutations = [NSCountedSet set];
+    NSUInteger count = 6000;
+    for (NSUInteger index = 0; index < count; index++) {
+        NSMutableArray *array = [@[@1, @2, @3] mutableCopy];
+        [array shuffleUsingRandomSource:random];
+        [permutations addObject:[array componentsJoinedByString:@""]];
+    }
+    XCTAssertEqual(permutations.count, (NSUInteger)6, @"All permutations should be returned");
+    for (NSString *permutation in permutations) {
+        NSUInteger permutationCount = [permutations countForObject:permutation];
+        XCTAssert(permutationCount > 850 && permutationCount < 1150, @"The permutation %@ is returned %lu times", permutation, (unsigned long)permutationCount);
+    }
+}
+
+- (void)test_shuffle_onEmptyArray_keepsArrayEmpty {
+    NSMutableArray *array = [NSMutableArray array];
+    [array shuffle];
+    XCTAssertEqual(array.count, 0, @"The array should have 0 elements");
+}
+
+- (void)test_performance_shuffle {
+    NSUInteger count = 500000;
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [array addObject:@(index)];
+    }
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSArray *result = [array arrayWithRandomizedOrder];
+    CFAbsoluteTime randomizedTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    [array shuffle];
+    CFAbsoluteTime shuffleTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(result.count, count, @"The result array should have the same number of elements");
+    XCTAssertEqual(array.count, count, @"The shuffled array should have the same number of elements");
+    NSLog(@"%lu elements, arrayWithRandomizedOrder: %.3fs, shuffle: %.3fs", (unsigned long)count, randomizedTime, shuffleTime);
+}
+
+#pragma mark - Concurrent processing
+
+- (NSArray *)numbersWithCount:(NSUInteger)count {
+    NSMutableArray *numbers = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [numbers addObject:@(index)];
+    }
+    return numbers;
+}
+
+- (void)test_enumerateChunksConcurrently_visitsEachElementOnce {
+    for (NSNumber *count in @[@0, @10, @1023, @1024, @100000]) {
+        NSArray *array = [self numbersWithCount:count.unsignedIntegerValue];
+        uint8_t *visits = calloc(array.count + 1, sizeof(uint8_t));
+        [array enumerateChunksConcurrentlyWithMaximumThreads:0 usingBlock:^(NSRange range, BOOL *stop) {
+            for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+                visits[index]++;
+            }
+        }];
+        NSUInteger visitedCount = 0;
+        for (NSUInteger index = 0; index < array.count; index++) {
+            visitedCount += visits[index] == 1;
+        }
+        free(visits);
+        XCTAssertEqual(visitedCount, array.count, @"Each of the %@ elements should be visited once", count);
+    }
+}
+
+- (void)test_concurrentlyMappedArray_returnsResultsInOrder {
+    for (NSNumber *count in @[@0, @100, @100000]) {
+        NSArray *array = [self numbersWithCount:count.unsignedIntegerValue];
+        NSArray *result = [array concurrentlyMappedArrayUsingBlock:^id(NSNumber *obj) {
+            return obj.integerValue % 7 == 0 ? nil : @(obj.integerValue * 2);
+        }];
+        XCTAssertEqual(result.count, array.count, @"The result array should have %@ elements", count);
+        for (NSUInteger index = 0; index < result.count; index++) {
+            id expected = index % 7 == 0 ? [NSNull null] : @(index * 2);
+            if (![result[index] isEqual:expected]) {
+                XCTFail(@"The result at %lu is not correct '%@'", (unsigned long)index, result[index]);
+                break;
+            }
+        }
+    }
+}
+
+- (void)test_concurrentlyFilteredArray_returnsPassingElementsInOrder {
+    for (NSNumber *count in @[@0, @100, @100000]) {
+        NSArray *array = [self numbersWithCount:count.unsignedIntegerValue];
+        BOOL (^predicate)(NSNumber *) = ^BOOL(NSNumber *obj) {
+            return obj.integerValue % 3 == 1;
+        };
+        NSArray *result = [array concurrentlyFilteredArrayUsingBlock:predicate];
+        NSArray *expected = [array filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(id obj, NSDictionary *bindings) {
+            return predicate(obj);
+        }]];
+        XCTAssertEqualObjects(result, expected, @"The result for %@ elements is not correct", count);
+    }
+}
+
+- (void)test_concurrentlyReducedObject_returnsSum {
+    for (NSNumber *count in @[@0, @100, @100000]) {
+        NSArray *array = [self numbersWithCount:count.unsignedIntegerValue];
+        NSNumber *result = [array concurrentlyReducedObjectWithInitialValue:@0 reduceBlock:^id(NSNumber *result, NSNumber *obj) {
+            return @(result.longLongValue + obj.longLongValue);
+        } combineBlock:^id(NSNumber *result, NSNumber *otherResult) {
+            return @(result.longLongValue + otherResult.longLongValue);
+        }];
+        long long n = count.longLongValue;
+        XCTAssertEqual(result.longLongValue, n * (n - 1) / 2, @"The sum of %@ elements is not correct", count);
+    }
+
+    // the chunks' results are combined in order
+    NSArray *strings = [[self numbersWithCount:5000] valueForKey:@"stringValue"];
+    NSString *joined = [strings concurrentlyReducedObjectWithInitialValue:@"" reduceBlock:^id(NSString *result, NSString *obj) {
+        return [result stringByAppendingString:obj];
+    } combineBlock:^id(NSString *result, NSString *otherResult) {
+        return [result stringByAppendingString:otherResult];
+    }];
+    XCTAssertEqualObjects(joined, [strings componentsJoinedByString:@""], @"The strings are not combined in order");
+}
+
+- (void)test_anyObjectPassingTest_stopsAfterMatch {
+    NSArray *array = [self numbersWithCount:100000];
+    XCTAssert([array anyObjectPassingTest:^BOOL(NSNumber *obj) { return obj.integerValue == 99999; }], @"The last element should be found");
+    XCTAssert(![array anyObjectPassingTest:^BOOL(NSNumber *obj) { return obj.integerValue < 0; }], @"No element should be found");
+    XCTAssert(![@[] anyObjectPassingTest:^BOOL(id obj) { return YES; }], @"No element should be found in an empty array");
+
+    atomic_uint tested = 0;
+    atomic_uint *testedPointer = &tested;
+    BOOL result = [array anyObjectPassingTest:^BOOL(NSNumber *obj) {
+        atomic_fetch_add(testedPointer, 1);
+        return obj.integerValue % 1000 == 0;
+    }];
+    XCTAssert(result, @"An element should be found");
+    XCTAssert(atomic_load(&tested) < array.count / 2, @"The search should stop early, but tested %u elements", atomic_load(&tested));
+}
+
+- (void)test_performance_enumerateChunksConcurrently {
+    NSArray *array = [self numbersWithCount:1000000];
+    NSUInteger processorCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    CFAbsoluteTime singleThreadTime = 0;
+    for (NSUInteger threads = 1; threads <= processorCount; threads++) {
+        atomic_ullong checksum = 0;
+        atomic_ullong *checksumPointer = &checksum;
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        [array enumerateChunksConcurrentlyWithMaximumThreads:threads usingBlock:^(NSRange range, BOOL *stop) {
+            unsigned long long sum = 0;
+            for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+                sum += [[array[index] stringValue] hash] % 1000;
+            }
+            atomic_fetch_add(checksumPointer, sum);
+        }];
+        CFAbsoluteTime time = CFAbsoluteTimeGetCurrent() - startTime;
+        if (threads == 1) {
+            singleThreadTime = time;
+        }
+        XCTAssert(atomic_load(&checksum) > 0, @"The elements should be processed");
+        NSLog(@"%lu threads: %.3fs, speedup %.2f", (unsigned long)threads, time, singleThreadTime / time);
+    }
+}
+
+
+#pragma mark - INWeightedSampler
+
+- (void)test_INWeightedSampler_withWeights_drawsObjectsByProbability {
+    NSArray *objects = @[@"A", @"B", @"C", @"D", @"E"];
+    INWeightedSampler *sampler = [INWeightedSampler samplerWithObjects:objects weights:@[@1, @2, @3, @4, @0]];
+    XCTAssertEqualWithAccuracy([sampler probabilityOfObjectAtIndex:3], 0.4, 0.000001, @"The probability is not correct");
+
+    NSUInteger count = 100000;
+    NSUInteger *indexes = malloc(count * sizeof(NSUInteger));
+    [sampler getRandomIndexes:indexes count:count usingRandomSource:[INSeededRandom randomWithSeed:23]];
+    NSUInteger counts[5] = {0};
+    for (NSUInteger index = 0; index < count; index++) {
+        counts[indexes[index]]++;
+    }
+    free(indexes);
+    for (NSUInteger index = 0; index < objects.count; index++) {
+        double expected = [sampler probabilityOfObjectAtIndex:index] * count;
+        XCTAssertEqualWithAccuracy((double)counts[index], expected, 0.02 * count, @"The object %@ is drawn %lu times", objects[index], (unsigned long)counts[index]);
+    }
+    XCTAssertEqual(counts[4], 0, @"An object with the weight 0 should never be drawn");
+
+    NSArray *result = [sampler randomObjectsWithCount:20 usingRandomSource:[INSeededRandom randomWithSeed:23]];
+    NSArray *other = [sampler randomObjectsWithCount:20 usingRandomSource:[INSeededRandom randomWithSeed:23]];
+    XCTAssertEqualObjects(result, other, @"The same seed should return the same objects");
+    XCTAssert([objects containsObject:[sampler randomObject]], @"The drawn object should be one of the objects");
+}
+
+- (void)test_INWeightedSampler_withInvalidWeights_returnsNil {
+    XCTAssertNil([INWeightedSampler samplerWithObjects:@[] weights:@[]], @"No objects should be invalid");
+    XCTAssertNil([INWeightedSampler samplerWithObjects:@[@"A", @"B"] weights:@[@1]], @"Missing weights should be invalid");
+    XCTAssertNil([INWeightedSampler samplerWithObjects:@[@"A", @"B"] weights:@[@1, @-1]], @"Negative weights should be invalid");
+    XCTAssertNil([INWeightedSampler samplerWithObjects:@[@"A", @"B"] weights:@[@0, @0]], @"Only zero weights should be invalid");
+    XCTAssertNil([INWeightedSampler samplerWithObjects:@[@"A"] weights:@[@(NAN)]], @"NaN should be invalid");
+}
+
+- (void)test_performance_INWeightedSampler {
+    NSUInteger objectCount = 1000;
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:objectCount];
+    NSMutableArray *weights = [NSMutableArray arrayWithCapacity:objectCount];
+    for (NSUInteger index = 0; index < objectCount; index++) {
+        [objects addObject:@(index)];
+        [weights addObject:@(index % 10 + 1)];
+    }
+    INWeightedSampler *sampler = [INWeightedSampler samplerWithObjects:objects weights:weights];
+    NSUInteger count = 1000000;
+    NSUInteger *indexes = malloc(count * sizeof(NSUInteger));
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    [sampler getRandomIndexes:indexes count:count usingRandomSource:nil];
+    CFAbsoluteTime drawTime = CFAbsoluteTimeGetCurrent() - startTime;
+    free(indexes);
+    NSLog(@"INWeightedSampler: %.0f draws/s from %lu objects", count / drawTime, (unsigned long)objectCount);
+}
+
 
 @end
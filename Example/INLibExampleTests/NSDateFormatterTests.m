@@ -0,0 +1,379 @@
+// NSDateFormatterTests.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import <XCTest/XCTest.h>
+
+@interface NSDateFormatterTests : XCTestCase
+
+@end
+
+
+@implementation NSDateFormatterTests
+
+- (void)setUp {
+    [super setUp];
+}
+
+- (void)tearDown {
+    [super tearDown];
+}
+
+
+#pragma mark - Caching formatters
+
+- (void)test_cachedDateFormatterForFormat {
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd"];
+    XCTAssertNotNil(formatter, @"Result is not correct");
+    XCTAssertEqualObjects(formatter.dateFormat, @"yyyy-MM-dd", @"Result is not correct '%@'", formatter.dateFormat);
+    XCTAssertEqualObjects(formatter.locale, [NSLocale currentLocale], @"Result is not correct '%@'", formatter.locale);
+    XCTAssertEqual([NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd"], formatter, @"The formatter should be cached");
+    XCTAssertNotEqual([NSDateFormatter cachedDateFormatterForFormat:@"yyyy"], formatter, @"Another format should result in another formatter");
+}
+
+- (void)test_cachedDateFormatterForFormat_locale_timeZone {
+    NSString *format = @"yyyy-MM-dd HH:mm";
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    NSTimeZone *timeZone = [NSTimeZone timeZoneForSecondsFromGMT:3600];
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:format locale:locale timeZone:timeZone];
+    XCTAssertEqualObjects(formatter.locale.localeIdentifier, @"en_US_POSIX", @"Result is not correct '%@'", formatter.locale);
+    XCTAssertEqualObjects(formatter.timeZone, timeZone, @"Result is not correct '%@'", formatter.timeZone);
+    NSString *result = [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:0]];
+    XCTAssertEqualObjects(result, @"2001-01-01 01:00", @"Result is not correct '%@'", result);
+
+    // equal, but not identical keys return the cached formatter
+    NSDateFormatter *cached = [NSDateFormatter cachedDateFormatterForFormat:[format mutableCopy] locale:[NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"] timeZone:[NSTimeZone timeZoneForSecondsFromGMT:3600]];
+    XCTAssertEqual(cached, formatter, @"The formatter should be cached");
+    cached = [NSDateFormatter cachedDateFormatterForFormat:format locale:locale timeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
+    XCTAssertNotEqual(cached, formatter, @"Another time zone should result in another formatter");
+}
+
+- (void)test_cachedDateFormatterForFormat_isBounded {
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"'first'"];
+    for (NSInteger index = 0; index < 100; index++) {
+        [NSDateFormatter cachedDateFormatterForFormat:[NSString stringWithFormat:@"'%ld'", (long)index]];
+    }
+    XCTAssertNotEqual([NSDateFormatter cachedDateFormatterForFormat:@"'first'"], formatter, @"The least recently used formatter should have been removed");
+}
+
+- (void)addCachedDateFormatterToArray:(NSMutableArray *)formatters {
+    [formatters addObject:[NSDateFormatter cachedDateFormatterForFormat:@"yyyy"]];
+}
+
+- (void)test_cachedDateFormatterForFormat_perThread {
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy"];
+    NSMutableArray *formatters = [NSMutableArray array];
+    NSThread *thread = [[NSThread alloc] initWithTarget:self selector:@selector(addCachedDateFormatterToArray:) object:formatters];
+    [thread start];
+    while (!thread.isFinished) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    XCTAssertEqual(formatters.count, 1, @"Result is not correct");
+    XCTAssertNotEqual(formatters.firstObject, formatter, @"Each thread should get its own formatter");
+}
+
+- (void)test_cachedDateFormatterForFormat_memoryWarning {
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy"];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:[UIApplication sharedApplication]];
+    XCTAssertNotEqual([NSDateFormatter cachedDateFormatterForFormat:@"yyyy"], formatter, @"The cache should have been cleared");
+}
+
+- (void)test_performance_cachedDateFormatterForFormat_concurrently {
+    NSUInteger iterations = 100000;
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:thread * 86400.0];
+        for (NSUInteger index = 0; index < iterations / 8; index++) {
+            NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd"];
+            if (index % 100 == 0) {
+                XCTAssertNotNil([formatter stringFromDate:date], @"Result is not correct");
+            }
+        }
+    });
+    CFAbsoluteTime time = CFAbsoluteTimeGetCurrent() - startTime;
+    NSLog(@"cachedDateFormatterForFormat: on 8 threads: %.0f lookups/s", iterations / time);
+}
+
+
+#pragma mark - ISO 8601
+
+- (void)test_INISO8601StringFromTimeInterval_matchesFormatter {
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    srand48(8601);
+    for (NSInteger index = 0; index < 5000; index++) {
+        // dates between 1901 and 2099 with fractions exactly representable by a double
+        NSTimeInterval timeInterval = floor((drand48() - 0.5) * 6.2e9 * 8) / 8;
+        NSInteger secondsFromGMT = (NSInteger)(drand48() * 104 - 48) * 900;
+        NSTimeZone *timeZone = [NSTimeZone timeZoneForSecondsFromGMT:secondsFromGMT];
+        NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ" locale:locale timeZone:timeZone];
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval];
+
+        NSString *expected = [formatter stringFromDate:date];
+        NSString *result = INISO8601StringFromTimeInterval(timeInterval, secondsFromGMT, 3);
+        XCTAssertEqualObjects(result, expected, @"Result is not correct for %f", timeInterval);
+
+        NSTimeInterval parsed;
+        XCTAssertTrue(INISO8601ParseString(expected, &parsed, NULL), @"Result is not correct for '%@'", expected);
+        XCTAssertEqual(parsed, [[formatter dateFromString:expected] timeIntervalSinceReferenceDate], @"Result is not correct for '%@'", expected);
+    }
+}
+
+- (void)test_INISO8601ParseString {
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    NSTimeZone *timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd" locale:locale timeZone:timeZone];
+    NSTimeInterval timeInterval;
+    INDateInformation dateInfo;
+    XCTAssertTrue(INISO8601ParseString(@"2016-02-29", &timeInterval, &dateInfo), @"Result is not correct");
+    XCTAssertEqual(timeInterval, [[formatter dateFromString:@"2016-02-29"] timeIntervalSinceReferenceDate], @"Result is not correct");
+    XCTAssert(dateInfo.year == 2016 && dateInfo.month == 2 && dateInfo.day == 29 && dateInfo.weekday == 2, @"Result is not correct");
+
+    formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd'T'HH:mm:ssZZZZZ" locale:locale timeZone:timeZone];
+    NSArray *strings = @[@"2016-02-29T13:45:10Z", @"2016-02-29T13:45:10+01:00", @"2016-02-29T13:45:10-09:30"];
+    for (NSString *string in strings) {
+        XCTAssertTrue(INISO8601ParseString(string, &timeInterval, &dateInfo), @"Result is not correct for '%@'", string);
+        XCTAssertEqual(timeInterval, [[formatter dateFromString:string] timeIntervalSinceReferenceDate], @"Result is not correct for '%@'", string);
+        XCTAssert(dateInfo.hour == 13 && dateInfo.minute == 45 && dateInfo.second == 10, @"Result is not correct for '%@'", string);
+    }
+
+    XCTAssertTrue(INISO8601ParseString(@"2001-01-01 01:30+0130", &timeInterval, NULL), @"Result is not correct");
+    XCTAssertEqual(timeInterval, 0, @"Result is not correct");
+    XCTAssertTrue(INISO8601ParseString(@"2001-01-01T00:00:00.25", &timeInterval, NULL), @"Result is not correct");
+    XCTAssertEqual(timeInterval, 0.25, @"Result is not correct");
+    XCTAssertTrue(INISO8601ParseString([NSString stringWithFormat:@"%@", @"2001-01-01T00:00:00,5-00"], &timeInterval, NULL), @"Result is not correct");
+    XCTAssertEqual(timeInterval, 0.5, @"Result is not correct");
+
+    NSArray *invalidStrings = @[@"", @"2015-02-29", @"2016-13-01", @"2016-01-01T24:00", @"2016-01-01T", @"2016-01-01T10:00+01:", @"2016-01-01T10:00:00.Z", @"2016-01-01T10:00:00Zx", @"16-01-01", @"2016-01-01T10:00:00\u00a0"];
+    for (NSString *string in invalidStrings) {
+        XCTAssertFalse(INISO8601ParseString(string, &timeInterval, NULL), @"Result is not correct for '%@'", string);
+    }
+    XCTAssertFalse(INISO8601ParseString(nil, &timeInterval, NULL), @"Result is not correct");
+}
+
+- (void)test_INISO8601FormatUTF8 {
+    char buffer[INISO8601MaximumLength + 1];
+    size_t length = INISO8601FormatUTF8(0, 3600, 3, buffer, sizeof(buffer));
+    XCTAssertEqual(length, 29, @"Result is not correct '%lu'", (unsigned long)length);
+    XCTAssert(strcmp(buffer, "2001-01-01T01:00:00.000+01:00") == 0, @"Result is not correct '%s'", buffer);
+    length = INISO8601FormatUTF8(-0.001, -5400, 6, buffer, sizeof(buffer));
+    XCTAssert(strcmp(buffer, "2000-12-31T22:29:59.999000-01:30") == 0, @"Result is not correct '%s'", buffer);
+    XCTAssertEqual(length, INISO8601MaximumLength, @"Result is not correct '%lu'", (unsigned long)length);
+    length = INISO8601FormatUTF8(0.75, 0, 0, buffer, sizeof(buffer));
+    XCTAssert(strcmp(buffer, "2001-01-01T00:00:00Z") == 0, @"Result is not correct '%s'", buffer);
+    XCTAssertEqual(INISO8601FormatUTF8(0, 3600, 3, buffer, 29), 0, @"The buffer should be too small");
+}
+
+- (void)test_performance_INISO8601ParseString {
+    NSUInteger count = 100000;
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [strings addObject:INISO8601StringFromTimeInterval(index * 3607.125, 3600, 3)];
+    }
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ" locale:[NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"] timeZone:nil];
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval formatterSum = 0;
+    for (NSString *string in strings) {
+        formatterSum += [[formatter dateFromString:string] timeIntervalSinceReferenceDate];
+    }
+    CFAbsoluteTime formatterTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval sum = 0;
+    for (NSString *string in strings) {
+        NSTimeInterval timeInterval = 0;
+        INISO8601ParseString(string, &timeInterval, NULL);
+        sum += timeInterval;
+    }
+    CFAbsoluteTime parseTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(sum, formatterSum, @"Result is not correct");
+    NSLog(@"NSDateFormatter: %.0f dates/s, INISO8601ParseString: %.0f dates/s", count / formatterTime, count / parseTime);
+}
+
+
+#pragma mark - Parsing in bulk
+
+- (void)test_parseDateStrings_matchesFormatter {
+    NSString *format = @"dd.MM.yyyy HH:mm";
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"de_DE"];
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:format locale:locale timeZone:timeZone];
+    NSUInteger count = 20000;
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        if (index % 97 == 0) {
+            [strings addObject:@"31.02.2016 10:00 invalid"];
+        } else if (index % 1001 == 0) {
+            [strings addObject:[NSNull null]];
+        } else {
+            [strings addObject:[formatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:index * 7207.0]]];
+        }
+    }
+
+    NSTimeInterval *timeIntervals = malloc(count * sizeof(NSTimeInterval));
+    NSIndexSet *invalidIndexes = [NSDateFormatter parseDateStrings:strings withFormat:format locale:locale timeZone:timeZone intoTimeIntervals:timeIntervals];
+    for (NSUInteger index = 0; index < count; index++) {
+        id string = strings[index];
+        NSDate *date = [string isKindOfClass:[NSString class]] ? [formatter dateFromString:string] : nil;
+        if (date == nil) {
+            XCTAssertTrue([invalidIndexes containsIndex:index], @"Result is not correct for %lu", (unsigned long)index);
+            XCTAssertTrue(isnan(timeIntervals[index]), @"Result is not correct for %lu", (unsigned long)index);
+        } else {
+            XCTAssertFalse([invalidIndexes containsIndex:index], @"Result is not correct for %lu", (unsigned long)index);
+            XCTAssertEqual(timeIntervals[index], [date timeIntervalSinceReferenceDate], @"Result is not correct for %lu", (unsigned long)index);
+        }
+    }
+    XCTAssertTrue(invalidIndexes.count > count / 97, @"Result is not correct '%lu'", (unsigned long)invalidIndexes.count);
+    free(timeIntervals);
+}
+
+- (void)test_parseUTF8DateStrings {
+    const char *strings[] = {"2016-02-29", NULL, "2016-02-30", "2001-01-01", "\xff\xfe"};
+    NSTimeInterval timeIntervals[5];
+    NSIndexSet *invalidIndexes = [NSDateFormatter parseUTF8DateStrings:strings count:5 withFormat:@"yyyy-MM-dd" locale:[NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"] timeZone:[NSTimeZone timeZoneForSecondsFromGMT:0] intoTimeIntervals:timeIntervals];
+    NSMutableIndexSet *expectedIndexes = [NSMutableIndexSet indexSetWithIndex:1];
+    [expectedIndexes addIndex:2];
+    [expectedIndexes addIndex:4];
+    XCTAssertEqualObjects(invalidIndexes, expectedIndexes, @"Result is not correct '%@'", invalidIndexes);
+    XCTAssertEqual(timeIntervals[0], 478396800.0, @"Result is not correct");
+    XCTAssertEqual(timeIntervals[3], 0.0, @"Result is not correct");
+}
+
+- (void)test_performance_parseDateStrings {
+    NSString *format = @"yyyy-MM-dd HH:mm:ss";
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:format locale:locale timeZone:nil];
+    NSUInteger count = 100000;
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [strings addObject:[formatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:index * 3607.0]]];
+    }
+    NSTimeInterval *timeIntervals = malloc(count * sizeof(NSTimeInterval));
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger index = 0; index < count; index++) {
+        timeIntervals[index] = [[formatter dateFromString:strings[index]] timeIntervalSinceReferenceDate];
+    }
+    CFAbsoluteTime serialTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSIndexSet *invalidIndexes = [NSDateFormatter parseDateStrings:strings withFormat:format locale:locale timeZone:nil intoTimeIntervals:timeIntervals];
+    CFAbsoluteTime bulkTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(invalidIndexes.count, 0, @"Result is not correct");
+    free(timeIntervals);
+    NSLog(@"dateFromString: %.0f dates/s, parseDateStrings: %.0f dates/s", count / serialTime, count / bulkTime);
+}
+
+
+#pragma mark - Date patterns
+
+- (void)test_INDatePattern_matchesFormatter {
+    NSArray *formats = @[@"dd.MM.yyyy HH:mm", @"EEEE, d. MMMM yyyy", @"EEE MMM dd HH:mm:ss ZZZZZ yyyy", @"h:mm a", @"yy-M-d'T'kk:mm:ss.SSS Z", @"K:mm a, LLLL LLL MMMMM EEEEE", @"D DDD 'o''clock' ''", @"yyyy-MM-dd HH:mm:ss.S SSSSSSS"];
+    NSArray *locales = @[@"en_US_POSIX", @"de_DE", @"fr_FR", @"ja_JP"];
+    NSArray *timeZones = @[[NSTimeZone timeZoneForSecondsFromGMT:0], [NSTimeZone timeZoneWithName:@"Europe/Berlin"], [NSTimeZone timeZoneForSecondsFromGMT:-12600]];
+    srand48(35);
+    for (NSString *format in formats) {
+        for (NSString *identifier in locales) {
+            NSLocale *locale = [NSLocale localeWithLocaleIdentifier:identifier];
+            for (NSTimeZone *timeZone in timeZones) {
+                INDatePattern *pattern = [INDatePattern patternWithFormat:format locale:locale timeZone:timeZone];
+                XCTAssertNotNil(pattern, @"Result is not correct for '%@'", format);
+                NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:format locale:locale timeZone:timeZone];
+                for (NSInteger index = 0; index < 200; index++) {
+                    // dates between 1901 and 2099 with fractions exactly representable by a double
+                    NSTimeInterval timeInterval = floor((drand48() - 0.5) * 6.2e9 * 8) / 8;
+                    NSString *expected = [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval]];
+                    NSString *result = [pattern stringFromTimeInterval:timeInterval];
+                    XCTAssertEqualObjects(result, expected, @"Result is not correct for '%@' %@ %@ %f", format, identifier, timeZone.name, timeInterval);
+                }
+            }
+        }
+    }
+}
+
+- (void)test_INDatePattern_formatDateInformation {
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"de_DE"];
+    INDatePattern *pattern = [INDatePattern patternWithFormat:@"EEEE, d. MMMM yyyy HH:mm ZZZZZ" locale:locale timeZone:[NSTimeZone timeZoneWithName:@"Europe/Berlin"]];
+    INDateInformation dateInfo = INDateInformationMake(2016, 7, 29, 13, 5, 0);
+    char buffer[64];
+    size_t length = [pattern formatDateInformation:dateInfo intoBuffer:buffer size:sizeof(buffer)];
+    XCTAssert(strcmp(buffer, "Freitag, 29. Juli 2016 13:05 +02:00") == 0, @"Result is not correct '%s'", buffer);
+    XCTAssertEqual(length, strlen(buffer), @"Result is not correct '%lu'", (unsigned long)length);
+
+    // too small buffers are cut and null terminated like snprintf
+    XCTAssertEqual([pattern formatDateInformation:dateInfo intoBuffer:buffer size:8], length, @"Result is not correct");
+    XCTAssert(strcmp(buffer, "Freitag") == 0, @"Result is not correct '%s'", buffer);
+
+    NSMutableString *string = [NSMutableString stringWithString:@"> "];
+    [pattern appendDateInformation:INDateInformationMake(2016, 1, 1, 0, 0, 0) toString:string];
+    XCTAssertEqualObjects(string, @"> Freitag, 1. Januar 2016 00:00 +01:00", @"Result is not correct '%@'", string);
+    NSString *result = [[INDatePattern patternWithFormat:@"dd.MM.yyyy" locale:locale timeZone:nil] stringFromDateInformation:dateInfo];
+    XCTAssertEqualObjects(result, @"29.07.2016", @"Result is not correct '%@'", result);
+}
+
+- (void)test_INDatePattern_unsupportedFormats {
+    NSArray *formats = @[@"yyyy G", @"Q", @"ZZZZ", @"MMMMMM", @"ddd", @"EEEEEE", @"aaaa", @"VV"];
+    for (NSString *format in formats) {
+        XCTAssertNil([INDatePattern patternWithFormat:format locale:nil timeZone:nil], @"Result is not correct for '%@'", format);
+        XCTAssertNil([NSDateFormatter cachedDatePatternForFormat:format locale:nil timeZone:nil], @"Result is not correct for '%@'", format);
+    }
+    XCTAssertNotNil([INDatePattern patternWithFormat:@"'G Q' yyyy" locale:nil timeZone:nil], @"Quoted letters should be supported");
+}
+
+- (void)test_cachedDatePatternForFormat {
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    INDatePattern *pattern = [NSDateFormatter cachedDatePatternForFormat:@"yyyy-MM-dd" locale:locale timeZone:nil];
+    XCTAssertNotNil(pattern, @"Result is not correct");
+    XCTAssertEqualObjects(pattern.timeZone, [NSTimeZone defaultTimeZone], @"Result is not correct '%@'", pattern.timeZone);
+    XCTAssertEqual([NSDateFormatter cachedDatePatternForFormat:@"yyyy-MM-dd" locale:locale timeZone:nil], pattern, @"The pattern should be cached");
+    XCTAssertNotEqual([NSDateFormatter cachedDatePatternForFormat:@"yyyy-MM-dd" locale:[NSLocale localeWithLocaleIdentifier:@"de_DE"] timeZone:nil], pattern, @"Another locale should result in another pattern");
+}
+
+- (void)test_performance_INDatePattern {
+    NSUInteger count = 100000;
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"de_DE"];
+    NSDateFormatter *formatter = [NSDateFormatter cachedDateFormatterForFormat:@"dd.MM.yyyy HH:mm" locale:locale timeZone:nil];
+    INDatePattern *pattern = [NSDateFormatter cachedDatePatternForFormat:@"dd.MM.yyyy HH:mm" locale:locale timeZone:nil];
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger formatterLength = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        formatterLength += [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:index * 3607.0]].length;
+    }
+    CFAbsoluteTime formatterTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger length = 0;
+    char buffer[64];
+    for (NSUInteger index = 0; index < count; index++) {
+        length += [pattern formatTimeInterval:index * 3607.0 intoBuffer:buffer size:sizeof(buffer)];
+    }
+    CFAbsoluteTime patternTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(length, formatterLength, @"Result is not correct");
+    NSLog(@"NSDateFormatter: %.0f dates/s, INDatePattern: %.0f dates/s", count / formatterTime, count / patternTime);
+}
+
+
+@end
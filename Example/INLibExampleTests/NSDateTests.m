@@ -33,6 +33,55 @@
 }
 
 
+#pragma mark - Cached Calendar
+
+- (void)test_threadGregorianCalendar {
+    NSCalendar *cachedCalendar = [NSDate cachedGregorianCalendar];
+    NSCalendar *threadCalendar = [NSDate threadGregorianCalendar];
+    XCTAssert(threadCalendar != cachedCalendar, @"The thread should use a copy of the cached calendar");
+    XCTAssert(threadCalendar == [NSDate threadGregorianCalendar], @"The thread's calendar should be reused");
+    XCTAssertEqualObjects(threadCalendar.timeZone, cachedCalendar.timeZone, @"The copy should use the same time zone");
+
+    // changing the cached calendar directly is detected
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:3600];
+    }
+    threadCalendar = [NSDate threadGregorianCalendar];
+    XCTAssertEqual(threadCalendar.timeZone.secondsFromGMT, 3600, @"The thread's calendar should use the changed time zone");
+
+    // setting a new calendar is detected by all threads
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    calendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    calendar.firstWeekday = 3;
+    [NSDate setCachedGregorianCalendar:calendar];
+    XCTAssertEqual([NSDate threadGregorianCalendar].firstWeekday, 3, @"The thread's calendar should be replaced");
+    __block NSUInteger otherThreadFirstWeekday = 0;
+    dispatch_sync(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        otherThreadFirstWeekday = [NSDate threadGregorianCalendar].firstWeekday;
+    });
+    XCTAssertEqual(otherThreadFirstWeekday, 3, @"The other thread's calendar should be replaced");
+
+    [NSDate setCachedGregorianCalendar:cachedCalendar];
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    }
+}
+
+- (void)test_threadGregorianCalendar_concurrently {
+    NSDate *date = [NSDate dateWithYear:2011 month:1 day:15];
+    NSUInteger count = 1000;
+    NSInteger *months = calloc(count, sizeof(NSInteger));
+    dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        NSDate *result = [date dateWithMonthsAdded:index];
+        months[index] = [date monthsBetweenDate:result];
+    });
+    for (NSUInteger index = 0; index < count; index++) {
+        XCTAssertEqual(months[index], (NSInteger)index, @"Result is not correct for index %lu", (unsigned long)index);
+    }
+    free(months);
+}
+
+
 #pragma mark - INDateInformation
 
 - (void)test_INDateInformation {
@@ -95,6 +144,193 @@
     XCTAssert(dateInfo.second == dateInfo2.second, @"Result '%ld' is not as expected '%ld'", (long)dateInfo.second, (long)dateInfo2.second);
 }
 
+- (void)test_INDateInformationFromTimeInterval {
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    NSUInteger components = NSCalendarUnitMonth | NSCalendarUnitMinute | NSCalendarUnitYear | NSCalendarUnitDay | NSCalendarUnitWeekday | NSCalendarUnitHour | NSCalendarUnitSecond;
+    NSArray *timeZones = @[[NSTimeZone timeZoneForSecondsFromGMT:0], [NSTimeZone timeZoneWithName:@"Europe/Berlin"], [NSTimeZone timeZoneWithName:@"America/New_York"], [NSTimeZone timeZoneWithName:@"Asia/Kolkata"]];
+    NSTimeInterval start = [[NSDate dateWithYear:1600 month:1 day:1] timeIntervalSinceReferenceDate];
+    NSTimeInterval end = [[NSDate dateWithYear:2100 month:1 day:1] timeIntervalSinceReferenceDate];
+    for (NSTimeZone *timeZone in timeZones) {
+        calendar.timeZone = timeZone;
+        // step a bit more than a week so every weekday and time of the day will be hit
+        for (NSTimeInterval timeInterval = start; timeInterval < end; timeInterval += 7 * 86400 + 3607.5) {
+            NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval];
+            NSDateComponents *comps = [calendar components:components fromDate:date];
+            INDateInformation info = INDateInformationFromTimeInterval(timeInterval, [timeZone secondsFromGMTForDate:date]);
+            BOOL equal = info.year == comps.year && info.month == comps.month && info.day == comps.day && info.weekday == comps.weekday && info.hour == comps.hour && info.minute == comps.minute && info.second == comps.second;
+            XCTAssert(equal, @"Result is not correct for '%@' in '%@'", date, timeZone.name);
+            if (!equal) {
+                return;
+            }
+        }
+    }
+}
+
+- (void)test_INDateInformationFillFromTimeIntervals {
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    calendar.timeZone = timeZone;
+    NSUInteger components = NSCalendarUnitMonth | NSCalendarUnitMinute | NSCalendarUnitYear | NSCalendarUnitDay | NSCalendarUnitWeekday | NSCalendarUnitHour | NSCalendarUnitSecond;
+
+    // an odd number of dates including some before the gregorian cutover, big enough to be processed concurrently
+    size_t count = 100003;
+    NSTimeInterval *timeIntervals = malloc(count * sizeof(NSTimeInterval));
+    INDateInformation *infos = malloc(count * sizeof(INDateInformation));
+    NSTimeInterval start = [[NSDate dateWithYear:1582 month:9 day:1] timeIntervalSinceReferenceDate];
+    for (size_t index = 0; index < count; index++) {
+        timeIntervals[index] = start + index * 43201.5;
+    }
+    INDateInformationFillFromTimeIntervals(timeIntervals, infos, count, timeZone);
+
+    for (size_t index = 0; index < count; index += 97) {
+        NSDateComponents *comps = [calendar components:components fromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:timeIntervals[index]]];
+        INDateInformation info = infos[index];
+        BOOL equal = info.year == comps.year && info.month == comps.month && info.day == comps.day && info.weekday == comps.weekday && info.hour == comps.hour && info.minute == comps.minute && info.second == comps.second;
+        XCTAssert(equal, @"Result is not correct for index %lu", (unsigned long)index);
+    }
+    // the last one is not a multiple of four
+    INDateInformation expected = INDateInformationFromTimeInterval(timeIntervals[count - 1], [timeZone secondsFromGMTForDate:[NSDate dateWithTimeIntervalSinceReferenceDate:timeIntervals[count - 1]]]);
+    XCTAssert(memcmp(&expected, &infos[count - 1], sizeof(INDateInformation)) == 0, @"Result is not correct for the last date");
+
+    free(timeIntervals);
+    free(infos);
+}
+
+- (void)test_performance_INDateInformationFillFromTimeIntervals {
+    // Compares the throughput of the batch decomposition with creating an NSDate for each time interval
+    size_t count = 1000000;
+    NSTimeInterval *timeIntervals = malloc(count * sizeof(NSTimeInterval));
+    INDateInformation *infos = malloc(count * sizeof(INDateInformation));
+    for (size_t index = 0; index < count; index++) {
+        timeIntervals[index] = index * 977.0;
+    }
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    for (size_t index = 0; index < count; index++) {
+        @autoreleasepool {
+            infos[index] = [[NSDate dateWithTimeIntervalSinceReferenceDate:timeIntervals[index]] dateInformation];
+        }
+    }
+    CFAbsoluteTime objectTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    INDateInformationFillFromTimeIntervals(timeIntervals, infos, count, nil);
+    CFAbsoluteTime batchTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    NSLog(@"dateInformation per NSDate: %.0f dates/s, INDateInformationFillFromTimeIntervals: %.0f dates/s", count / objectTime, count / batchTime);
+    free(timeIntervals);
+    free(infos);
+}
+
+- (void)test_INTimeZoneTable_secondsFromGMTForTimeInterval {
+    for (NSString *name in @[@"Europe/Berlin", @"America/New_York", @"Australia/Sydney", @"Asia/Tokyo"]) {
+        NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:name];
+        INTimeZoneTable *table = [INTimeZoneTable tableWithTimeZone:timeZone fromYear:1970 toYear:2030];
+        // start and end outside of the table's range
+        NSTimeInterval start = [[NSDate dateWithYear:1965 month:1 day:1] timeIntervalSinceReferenceDate];
+        NSTimeInterval end = [[NSDate dateWithYear:2035 month:1 day:1] timeIntervalSinceReferenceDate];
+        for (NSTimeInterval timeInterval = start; timeInterval < end; timeInterval += 3 * 3600 + 17) {
+            NSInteger expected = [timeZone secondsFromGMTForDate:[NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval]];
+            NSInteger result = [table secondsFromGMTForTimeInterval:timeInterval];
+            XCTAssertEqual(result, expected, @"Result is not correct for %f in '%@'", timeInterval, name);
+            if (result != expected) {
+                break;
+            }
+        }
+    }
+}
+
+- (void)test_INTimeZoneTable_withInvalidArguments_returnsNil {
+    INTimeZoneTable *table = [INTimeZoneTable tableWithTimeZone:nil fromYear:1970 toYear:2030];
+    XCTAssertNil(table, @"No table was expected without a time zone");
+
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    table = [INTimeZoneTable tableWithTimeZone:timeZone fromYear:2030 toYear:1970];
+    XCTAssertNil(table, @"No table was expected for an inverted range of years");
+
+    table = [INTimeZoneTable tableWithTimeZone:timeZone fromYear:2015 toYear:2015];
+    XCTAssertNotNil(table, @"A table was expected for a single year");
+}
+
+- (void)test_dateWithDateInformation_timeZoneTable {
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    INTimeZoneTable *table = [INTimeZoneTable tableWithTimeZone:timeZone fromYear:2000 toYear:2020];
+    // the days of the daylight saving time transitions and a normal day
+    NSArray *days = @[@[@2015, @3, @29], @[@2015, @10, @25], @[@2015, @7, @10]];
+    for (NSArray *day in days) {
+        for (NSInteger minutes = 0; minutes < 24 * 60; minutes += 15) {
+            INDateInformation dateInfo = INDateInformationMake([day[0] integerValue], [day[1] integerValue], [day[2] integerValue], minutes / 60, minutes % 60, 30);
+            NSDate *expected = [NSDate dateWithDateInformation:dateInfo timeZone:timeZone];
+            NSDate *result = [NSDate dateWithDateInformation:dateInfo timeZoneTable:table];
+            XCTAssert([result isEqualToDate:expected], @"Result '%@' is not as expected '%@'", result, expected);
+
+            INDateInformation info = [result dateInformationWithTimeZoneTable:table];
+            INDateInformation expectedInfo = INDateInformationFromTimeInterval(result.timeIntervalSinceReferenceDate, [timeZone secondsFromGMTForDate:result]);
+            XCTAssert(memcmp(&info, &expectedInfo, sizeof(INDateInformation)) == 0, @"Result is not correct for '%@'", result);
+        }
+    }
+}
+
+- (void)test_dateInformation_beforeGregorianCutover_usesCalendar {
+    // NSCalendar uses the julian calendar before the 15th October 1582
+    NSDate *date = [NSDate dateWithYear:1582 month:10 day:4];
+    INDateInformation dateInfo = [date dateInformation];
+    XCTAssert(dateInfo.day == 4, @"Result is not correct '%ld'", (long)dateInfo.day);
+
+    NSDate *nextDay = [date dateWithDaysAdded:1];
+    dateInfo = [nextDay dateInformation];
+    XCTAssert(dateInfo.year == 1582, @"Result is not correct '%ld'", (long)dateInfo.year);
+    XCTAssert(dateInfo.month == 10, @"Result is not correct '%ld'", (long)dateInfo.month);
+    XCTAssert(dateInfo.day == 15, @"Result is not correct '%ld'", (long)dateInfo.day);
+}
+
+- (void)test_performance_dateInformation_concurrently {
+    // Compares the arithmetic calculation with locking the shared calendar for each date with an increasing number of threads
+    NSUInteger numberOfDates = 200000;
+    NSCalendar *sharedCalendar = [NSDate cachedGregorianCalendar];
+    NSUInteger components = NSCalendarUnitMonth | NSCalendarUnitMinute | NSCalendarUnitYear | NSCalendarUnitDay | NSCalendarUnitWeekday | NSCalendarUnitHour | NSCalendarUnitSecond;
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    for (NSUInteger threads = 1; threads <= 16; threads *= 2) {
+        NSUInteger datesPerThread = numberOfDates / threads;
+        __block NSInteger checksum1 = 0;
+        __block NSInteger checksum2 = 0;
+
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        dispatch_apply(threads, queue, ^(size_t thread) {
+            NSInteger sum = 0;
+            for (NSUInteger i = 0; i < datesPerThread; i++) {
+                NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:(thread * datesPerThread + i) * 977.0];
+                NSDateComponents *comps;
+                @synchronized(sharedCalendar) {
+                    comps = [sharedCalendar components:components fromDate:date];
+                }
+                sum += comps.day;
+            }
+            @synchronized(queue) {
+                checksum1 += sum;
+            }
+        });
+        CFAbsoluteTime calendarTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+        startTime = CFAbsoluteTimeGetCurrent();
+        dispatch_apply(threads, queue, ^(size_t thread) {
+            NSInteger sum = 0;
+            for (NSUInteger i = 0; i < datesPerThread; i++) {
+                NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:(thread * datesPerThread + i) * 977.0];
+                sum += [date dateInformation].day;
+            }
+            @synchronized(queue) {
+                checksum2 += sum;
+            }
+        });
+        CFAbsoluteTime arithmeticTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+        XCTAssertEqual(checksum1, checksum2, @"Both paths should calculate the same days");
+        NSLog(@"dateInformation with %2lu threads: NSCalendar %.3fs, arithmetic %.3fs (%.1fx)", (unsigned long)threads, calendarTime, arithmeticTime, calendarTime / arithmeticTime);
+    }
+}
+
+
 
 #pragma mark - Date initializers
 
@@ -162,6 +398,55 @@
     XCTAssert([result isEqualToString:@"-00:00:59"], @"Result is not correct '%@'", result);
 }
 
+- (void)test_INDurationFormatUTF8 {
+    char buffer[INDurationMaximumLength + 1];
+    size_t length = INDurationFormatUTF8(-90061.5, INDurationFormatPrintSign | INDurationFormatPrintSeconds, 1, buffer, sizeof(buffer));
+    XCTAssert(strcmp(buffer, "-25:01:01.5") == 0, @"Result is not correct '%s'", buffer);
+    XCTAssertEqual(length, 11, @"Result is not correct '%lu'", (unsigned long)length);
+    INDurationFormatUTF8(-90061.5, INDurationFormatPrintSign | INDurationFormatPrintSeconds | INDurationFormatWrapHours, 0, buffer, sizeof(buffer));
+    XCTAssert(strcmp(buffer, "-01:01:01") == 0, @"Result is not correct '%s'", buffer);
+    INDurationFormatUTF8(123456789.125, INDurationFormatPrintSeconds, 3, buffer, sizeof(buffer));
+    XCTAssert(strcmp(buffer, "34293:33:09.125") == 0, @"Result is not correct '%s'", buffer);
+    INDurationFormatUTF8(0.999, 0, 3, buffer, sizeof(buffer));
+    XCTAssert(strcmp(buffer, "00:00") == 0, @"Fractions should only be written with seconds '%s'", buffer);
+
+    XCTAssertEqual(INDurationFormatUTF8(3723, INDurationFormatPrintSeconds, 0, buffer, 8), 0, @"The buffer should be too small");
+    XCTAssertEqual(INDurationFormatUTF8(3723, INDurationFormatPrintSeconds, 0, buffer, 9), 8, @"The buffer should be big enough");
+    XCTAssertEqual(INDurationFormatUTF8(NAN, 0, 0, buffer, sizeof(buffer)), 0, @"Result is not correct");
+    XCTAssertEqual(INDurationFormatUTF8(1e20, 0, 0, buffer, sizeof(buffer)), 0, @"Result is not correct");
+}
+
+- (void)test_INDurationStringsFromSeconds {
+    NSTimeInterval seconds[] = {3723, -59, 86400 * 5, INFINITY};
+    NSArray *result = INDurationStringsFromSeconds(seconds, 4, INDurationFormatPrintSign | INDurationFormatPrintSeconds, 0);
+    NSArray *expected = @[@"+01:02:03", @"-00:00:59", @"+120:00:00", @""];
+    XCTAssertEqualObjects(result, expected, @"Result is not correct '%@'", result);
+    XCTAssertEqualObjects(INDurationStringFromSeconds(-0.25, INDurationFormatPrintSign | INDurationFormatPrintSeconds, 2), @"-00:00:00.25", @"Result is not correct");
+    XCTAssertNil(INDurationStringFromSeconds(NAN, 0, 0), @"Result is not correct");
+}
+
+- (void)test_performance_INDurationFormatUTF8 {
+    NSUInteger count = 100000;
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger formatLength = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        NSInteger seconds = index * 37;
+        formatLength += [NSString stringWithFormat:@"%@%.2ld:%.2ld:%.2ld", @"+", labs((seconds / 3600) % 24), labs(seconds % 3600 / 60), labs(seconds % 60)].length;
+    }
+    CFAbsoluteTime formatTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger length = 0;
+    char buffer[INDurationMaximumLength + 1];
+    for (NSUInteger index = 0; index < count; index++) {
+        length += INDurationFormatUTF8(index * 37, INDurationFormatPrintSign | INDurationFormatPrintSeconds | INDurationFormatWrapHours, 0, buffer, sizeof(buffer));
+    }
+    CFAbsoluteTime durationTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(length, formatLength, @"Result is not correct");
+    NSLog(@"stringWithFormat: %.0f durations/s, INDurationFormatUTF8: %.0f durations/s", count / formatTime, count / durationTime);
+}
+
 
 #pragma mark - Comparing methods
 
@@ -175,6 +460,56 @@
     XCTAssert(result == NO, @"Result is not correct");
 }
 
+- (void)test_isToday_followsTimeZone {
+    NSCalendar *cachedCalendar = [NSDate cachedGregorianCalendar];
+    for (NSString *name in @[@"Europe/Berlin", @"Pacific/Kiritimati", @"Pacific/Pago_Pago"]) {
+        NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:name];
+        @synchronized(cachedCalendar) {
+            cachedCalendar.timeZone = timeZone;
+        }
+        NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+        calendar.timeZone = timeZone;
+        NSDate *startOfToday;
+        NSTimeInterval length;
+        [calendar rangeOfUnit:NSCalendarUnitDay startDate:&startOfToday interval:&length forDate:[NSDate date]];
+        NSDate *startOfTomorrow = [startOfToday dateByAddingTimeInterval:length];
+
+        XCTAssertTrue([[NSDate date] isToday], @"Result is not correct in '%@'", name);
+        XCTAssertTrue([startOfToday isToday], @"Result is not correct in '%@'", name);
+        XCTAssertFalse([[startOfToday dateByAddingTimeInterval:-0.5] isToday], @"Result is not correct in '%@'", name);
+        XCTAssertTrue([[startOfTomorrow dateByAddingTimeInterval:-0.5] isToday], @"Result is not correct in '%@'", name);
+        XCTAssertFalse([startOfTomorrow isToday], @"Result is not correct in '%@'", name);
+    }
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    }
+}
+
+- (void)test_performance_isToday {
+    NSUInteger count = 100000;
+    NSMutableArray *dates = [NSMutableArray arrayWithCapacity:count];
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    for (NSUInteger index = 0; index < count; index++) {
+        [dates addObject:[NSDate dateWithTimeIntervalSinceReferenceDate:now - index * 7.0]];
+    }
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger sameDayCount = 0;
+    for (NSDate *date in dates) {
+        sameDayCount += [date isSameDay:[NSDate date]] ? 1 : 0;
+    }
+    CFAbsoluteTime sameDayTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger todayCount = 0;
+    for (NSDate *date in dates) {
+        todayCount += [date isToday] ? 1 : 0;
+    }
+    CFAbsoluteTime todayTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssert(todayCount > 0, @"Result is not correct '%lu'", (unsigned long)todayCount);
+    NSLog(@"isSameDay: with now: %.0f dates/s, isToday: %.0f dates/s", count / sameDayTime, count / todayTime);
+}
+
 - (void)test_isSameDay {
     NSDate *date1 = [NSDate dateWithYear:2011 month:4 day:4 hour:2 minute:40 second:12];
     NSDate *date2 = [NSDate dateWithYear:2011 month:4 day:4 hour:22 minute:12 second:33];
@@ -239,6 +574,20 @@
     XCTAssertEqual(result, expected, @"Result is not correct %@ - %@", result, expected);
 }
 
+- (void)test_dateWithTimeZeroed_returnsMidnight {
+    NSDate *date = [NSDate dateWithYear:2011 month:4 day:4 hour:2 minute:40 second:12];
+    INDateInformation info = [[date dateWithTimeZeroed] dateInformation];
+    XCTAssertEqual(info.day, 4, @"Result is not correct %ld", (long)info.day);
+    XCTAssertEqual(info.hour, 0, @"Result is not correct %ld", (long)info.hour);
+    XCTAssertEqual(info.minute, 0, @"Result is not correct %ld", (long)info.minute);
+    XCTAssertEqual(info.second, 0, @"Result is not correct %ld", (long)info.second);
+
+    info = [date dateInformationForComponents:NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay];
+    XCTAssertEqual(info.year, 2011, @"Result is not correct %ld", (long)info.year);
+    XCTAssertEqual(info.hour, NSDateComponentUndefined, @"Result is not correct %ld", (long)info.hour);
+    XCTAssertEqual(info.weekday, NSDateComponentUndefined, @"Result is not correct %ld", (long)info.weekday);
+}
+
 - (void)test_dateWithDaysAdded {
     NSDate *date = [NSDate dateWithYear:2011 month:5 day:2];
     NSDate *result = [date dateWithDaysAdded:2];
@@ -388,6 +737,119 @@
     XCTAssertEqual(result, expected, @"Result is not correct %@ - %@", result, expected);
 }
 
+- (void)test_monthBoundaries_withDaylightSavingTime {
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    NSCalendar *cachedCalendar = [NSDate cachedGregorianCalendar];
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = timeZone;
+    }
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    calendar.timeZone = timeZone;
+
+    NSDateComponents *comps = [[NSDateComponents alloc] init];
+    comps.year = 2015;
+    comps.month = 1;
+    comps.hour = 13;
+    comps.minute = 45;
+    for (NSInteger day = 1; day <= 730; day++) {
+        comps.day = day;
+        NSDate *date = [calendar dateFromComponents:comps];
+        NSDateComponents *dateComps = [calendar components:NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay | NSCalendarUnitWeekday fromDate:date];
+        NSDateComponents *expectedComps = [[NSDateComponents alloc] init];
+        expectedComps.year = dateComps.year;
+        expectedComps.month = dateComps.month;
+        expectedComps.day = 1;
+        NSDate *expected = [calendar dateFromComponents:expectedComps];
+        XCTAssertEqualObjects([date dateWithFirstOfMonth], expected, @"Result is not correct for %@", date);
+        expectedComps.day = [calendar rangeOfUnit:NSCalendarUnitDay inUnit:NSCalendarUnitMonth forDate:date].length;
+        expected = [calendar dateFromComponents:expectedComps];
+        XCTAssertEqualObjects([date dateWithLastOfMonth], expected, @"Result is not correct for %@", date);
+        expected = [calendar dateFromComponents:[calendar components:NSCalendarUnitYear fromDate:date]];
+        XCTAssertEqualObjects([date dateWithFirstOfYear], expected, @"Result is not correct for %@", date);
+        NSDateComponents *addComps = [[NSDateComponents alloc] init];
+        addComps.day = -((dateComps.weekday - 2 + 7) % 7);
+        expected = [calendar dateByAddingComponents:addComps toDate:date options:0];
+        XCTAssertEqualObjects([date dateWithWeekstart:2], expected, @"Result is not correct for %@", date);
+
+        for (NSInteger months = -1; months <= 1; months += 2) {
+            // days not existing in the new month result in the month's last day at midnight
+            addComps = [[NSDateComponents alloc] init];
+            addComps.month = months;
+            expected = [calendar dateByAddingComponents:addComps toDate:date options:0];
+            NSDateComponents *resultComps = [calendar components:NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay fromDate:expected];
+            if (resultComps.day != dateComps.day) {
+                expected = [calendar dateFromComponents:resultComps];
+            }
+            NSDate *result = months > 0 ? [date dateWithNextMonth] : [date dateWithPrevMonth];
+            XCTAssertEqualObjects(result, expected, @"Result is not correct for %@", date);
+        }
+    }
+
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    }
+}
+
+- (void)test_INDateDaysInMonth {
+    XCTAssertEqual(INDateDaysInMonth(2015, 1), 31, @"Result is not correct");
+    XCTAssertEqual(INDateDaysInMonth(2015, 2), 28, @"Result is not correct");
+    XCTAssertEqual(INDateDaysInMonth(2016, 2), 29, @"Result is not correct");
+    XCTAssertEqual(INDateDaysInMonth(1900, 2), 28, @"Result is not correct");
+    XCTAssertEqual(INDateDaysInMonth(2000, 2), 29, @"Result is not correct");
+    XCTAssertEqual(INDateDaysInMonth(2015, 4), 30, @"Result is not correct");
+    XCTAssertEqual(INDateDaysInMonth(2015, 12), 31, @"Result is not correct");
+
+    BOOL clamped;
+    NSInteger days = INDateDaysByAddingMonths(INDateDaysFromCivil(2016, 1, 31), 1, &clamped);
+    XCTAssertEqual(days, INDateDaysFromCivil(2016, 2, 29), @"Result is not correct");
+    XCTAssertTrue(clamped, @"The day should have been clamped");
+    days = INDateDaysByAddingMonths(INDateDaysFromCivil(2016, 1, 15), -13, &clamped);
+    XCTAssertEqual(days, INDateDaysFromCivil(2014, 12, 15), @"Result is not correct");
+    XCTAssertFalse(clamped, @"The day should not have been clamped");
+}
+
+
+#pragma mark - PackedDate
+
+- (void)test_INPackedDate {
+    INPackedDate date = INPackedDateMake(2016, 1, 31, 12, 30, 15);
+    INDateInformation info = INDateInformationFromPackedDate(date);
+    XCTAssert(info.year == 2016 && info.month == 1 && info.day == 31 && info.weekday == 1, @"Result is not correct '%ld-%ld-%ld'", (long)info.year, (long)info.month, (long)info.day);
+    XCTAssert(info.hour == 12 && info.minute == 30 && info.second == 15, @"Result is not correct '%ld:%ld:%ld'", (long)info.hour, (long)info.minute, (long)info.second);
+    XCTAssertEqual(INPackedDateFromDateInformation(info), date, @"Result is not correct");
+    XCTAssertEqual(INPackedDateGetDays(date), INDateDaysFromCivil(2016, 1, 31), @"Result is not correct");
+    XCTAssertEqual(INPackedDateGetSecondsOfDay(date), 12 * 3600 + 30 * 60 + 15, @"Result is not correct");
+
+    XCTAssertEqual(INPackedDateAddDays(date, 1), INPackedDateMake(2016, 2, 1, 12, 30, 15), @"Result is not correct");
+    XCTAssertEqual(INPackedDateAddDays(date, -31), INPackedDateMake(2015, 12, 31, 12, 30, 15), @"Result is not correct");
+    XCTAssertEqual(INPackedDateAddMonths(date, 1), INPackedDateMake(2016, 2, 29, 12, 30, 15), @"Result is not correct");
+    XCTAssertEqual(INPackedDateAddMonths(date, -2), INPackedDateMake(2015, 11, 30, 12, 30, 15), @"Result is not correct");
+    XCTAssertEqual(INPackedDateMake(2015, 13, 1, 24, 0, 0), INPackedDateMake(2016, 1, 2, 0, 0, 0), @"Result is not correct");
+
+    INPackedDate before = INPackedDateMake(1969, 12, 31, 23, 59, 59);
+    INPackedDate after = INPackedDateMake(1970, 1, 1, 0, 0, 0);
+    XCTAssertEqual(INPackedDateGetDays(before), -1, @"Result is not correct");
+    XCTAssertEqual(INPackedDateGetSecondsOfDay(before), 86399, @"Result is not correct");
+    XCTAssertEqual(INPackedDateCompare(before, after), NSOrderedAscending, @"Result is not correct");
+    XCTAssertEqual(INPackedDateCompare(after, before), NSOrderedDescending, @"Result is not correct");
+    XCTAssertEqual(INPackedDateCompare(date, date), NSOrderedSame, @"Result is not correct");
+    XCTAssertNotEqual(INPackedDateHash(before), INPackedDateHash(after), @"Result is not correct");
+}
+
+- (void)test_packedDate {
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    NSDate *date = [NSDate dateWithDateInformation:INDateInformationMake(2015, 7, 24, 13, 45, 10) timeZone:timeZone];
+    XCTAssertEqual([date packedDateWithTimeZone:timeZone], INPackedDateMake(2015, 7, 24, 13, 45, 10), @"Result is not correct");
+    XCTAssertEqual([date packedDate], INPackedDateMake(2015, 7, 24, 11, 45, 10), @"Result is not correct");
+    XCTAssertEqualObjects([NSDate dateWithPackedDate:INPackedDateMake(2015, 7, 24, 13, 45, 10) timeZone:timeZone], date, @"Result is not correct");
+    XCTAssertEqualObjects([NSDate dateWithPackedDate:INPackedDateMake(2015, 7, 24, 11, 45, 10)], date, @"Result is not correct");
+
+    // the skipped hour is moved forward like NSCalendar does
+    NSDate *expected = [NSDate dateWithDateInformation:INDateInformationMake(2015, 3, 29, 2, 30, 0) timeZone:timeZone];
+    NSDate *result = [NSDate dateWithPackedDate:INPackedDateMake(2015, 3, 29, 2, 30, 0) timeZone:timeZone];
+    XCTAssertEqualObjects(result, expected, @"Result is not correct %@ - %@", result, expected);
+}
+
 
 #pragma mark - Date details accessing
 
@@ -711,4 +1173,199 @@
 }
 
 
+#pragma mark - Weeks
+
+- (void)test_INWeekRule {
+    NSInteger weekYear;
+    NSInteger week = INWeekRuleWeekOfYearFromDays(INDateDaysFromCivil(2016, 1, 1), INWeekRuleISO8601, &weekYear);
+    XCTAssert(week == 53 && weekYear == 2015, @"Result is not correct '%ld/%ld'", (long)week, (long)weekYear);
+    week = INWeekRuleWeekOfYearFromDays(INDateDaysFromCivil(2014, 12, 29), INWeekRuleISO8601, &weekYear);
+    XCTAssert(week == 1 && weekYear == 2015, @"Result is not correct '%ld/%ld'", (long)week, (long)weekYear);
+    week = INWeekRuleWeekOfYearFromDays(INDateDaysFromCivil(2015, 7, 24), INWeekRuleISO8601, &weekYear);
+    XCTAssert(week == 30 && weekYear == 2015, @"Result is not correct '%ld/%ld'", (long)week, (long)weekYear);
+    week = INWeekRuleWeekOfYearFromDays(INDateDaysFromCivil(2015, 12, 31), INWeekRuleUS, &weekYear);
+    XCTAssert(week == 1 && weekYear == 2016, @"Result is not correct '%ld/%ld'", (long)week, (long)weekYear);
+    week = INWeekRuleWeekOfYearFromDays(INDateDaysFromCivil(2016, 1, 1), INWeekRuleUS, &weekYear);
+    XCTAssert(week == 1 && weekYear == 2016, @"Result is not correct '%ld/%ld'", (long)week, (long)weekYear);
+
+    XCTAssertEqual(INWeekRuleWeekStartFromDays(INDateDaysFromCivil(2015, 7, 26), INWeekRuleISO8601), INDateDaysFromCivil(2015, 7, 20), @"Result is not correct");
+    XCTAssertEqual(INWeekRuleWeekStartFromDays(INDateDaysFromCivil(2015, 7, 26), INWeekRuleUS), INDateDaysFromCivil(2015, 7, 26), @"Result is not correct");
+    // the 1st August 2015 is a Saturday, so its week has only two days in August
+    XCTAssertEqual(INWeekRuleWeekOfMonthFromDays(INDateDaysFromCivil(2015, 8, 1), INWeekRuleISO8601), 0, @"Result is not correct");
+    XCTAssertEqual(INWeekRuleWeekOfMonthFromDays(INDateDaysFromCivil(2015, 8, 3), INWeekRuleISO8601), 1, @"Result is not correct");
+    XCTAssertEqual(INWeekRuleWeekOfMonthFromDays(INDateDaysFromCivil(2015, 8, 1), INWeekRuleUS), 1, @"Result is not correct");
+}
+
+- (void)test_weekNumbers_matchCalendar {
+    NSCalendar *cachedCalendar = [NSDate cachedGregorianCalendar];
+    NSArray *rules = @[@[@2, @4], @[@1, @1], @[@7, @3]];
+    for (NSArray *rule in rules) {
+        @synchronized(cachedCalendar) {
+            cachedCalendar.firstWeekday = [rule[0] integerValue];
+            cachedCalendar.minimumDaysInFirstWeek = [rule[1] integerValue];
+        }
+        NSCalendar *calendar = [[NSDate threadGregorianCalendar] copy];
+        INWeekRule weekRule = INWeekRuleMake([rule[0] integerValue], [rule[1] integerValue]);
+        NSDate *date = [NSDate dateWithYear:2010 month:12 day:1 hour:12 minute:0 second:0];
+        for (NSInteger day = 0; day < 2000; day++) {
+            NSDateComponents *comps = [calendar components:NSCalendarUnitWeekOfYear | NSCalendarUnitWeekOfMonth | NSCalendarUnitYearForWeekOfYear fromDate:date];
+            XCTAssertEqual([date weekNumberOfYear], comps.weekOfYear, @"Result is not correct for %@", date);
+            XCTAssertEqual([date weekNumberOfMonth], comps.weekOfMonth, @"Result is not correct for %@", date);
+            XCTAssertEqual([date weekNumberOfYearWithRule:weekRule], comps.weekOfYear, @"Result is not correct for %@", date);
+            XCTAssertEqual([date weekYearWithRule:weekRule], comps.yearForWeekOfYear, @"Result is not correct for %@", date);
+            XCTAssertEqual([date weekNumberOfMonthWithRule:weekRule], comps.weekOfMonth, @"Result is not correct for %@", date);
+            date = [date dateByAddingTimeInterval:86400];
+        }
+    }
+    @synchronized(cachedCalendar) {
+        cachedCalendar.firstWeekday = 2;
+        cachedCalendar.minimumDaysInFirstWeek = 4;
+    }
+}
+
+- (void)test_INWeekInformationFillFromTimeIntervals {
+    NSUInteger count = 1000;
+    NSTimeInterval *timeIntervals = malloc(count * sizeof(NSTimeInterval));
+    INWeekInformation *infos = malloc(count * sizeof(INWeekInformation));
+    for (NSUInteger index = 0; index < count; index++) {
+        timeIntervals[index] = index * 86400.0 * 3.3;
+    }
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"America/New_York"];
+    INWeekInformationFillFromTimeIntervals(timeIntervals, infos, count, INWeekRuleISO8601, timeZone);
+    for (NSUInteger index = 0; index < count; index++) {
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:timeIntervals[index]];
+        NSInteger days = INPackedDateGetDays([date packedDateWithTimeZone:timeZone]);
+        NSInteger weekYear;
+        NSInteger week = INWeekRuleWeekOfYearFromDays(days, INWeekRuleISO8601, &weekYear);
+        XCTAssert(infos[index].weekOfYear == week && infos[index].weekYear == weekYear, @"Result is not correct for %@", date);
+        XCTAssertEqual(infos[index].weekStartDays, INWeekRuleWeekStartFromDays(days, INWeekRuleISO8601), @"Result is not correct for %@", date);
+    }
+    free(timeIntervals);
+    free(infos);
+}
+
+
+#pragma mark - Date differences
+
+- (void)test_differencesBetweenDates_matchCalendar {
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Berlin"];
+    NSCalendar *cachedCalendar = [NSDate cachedGregorianCalendar];
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = timeZone;
+    }
+    NSCalendar *calendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+    calendar.timeZone = timeZone;
+
+    NSUInteger count = 2000;
+    NSTimeInterval *starts = malloc(count * sizeof(NSTimeInterval));
+    NSTimeInterval *ends = malloc(count * sizeof(NSTimeInterval));
+    NSInteger *days = malloc(count * sizeof(NSInteger));
+    NSInteger *months = malloc(count * sizeof(NSInteger));
+    NSInteger *years = malloc(count * sizeof(NSInteger));
+    srand48(42);
+    for (NSUInteger index = 0; index < count; index++) {
+        // random dates between 2000 and 2030 with mostly random, but also equal times of day
+        starts[index] = drand48() * 946080000.0;
+        ends[index] = index % 2 == 0 ? drand48() * 946080000.0 : starts[index] + 86400.0 * (NSInteger)(drand48() * 2000 - 1000);
+    }
+    INDateDifferencesBetweenTimeIntervals(starts, ends, days, count, NSCalendarUnitDay, timeZone);
+    INDateDifferencesBetweenTimeIntervals(starts, ends, months, count, NSCalendarUnitMonth, timeZone);
+    INDateDifferencesBetweenTimeIntervals(starts, ends, years, count, NSCalendarUnitYear, timeZone);
+
+    for (NSUInteger index = 0; index < count; index++) {
+        NSDate *start = [NSDate dateWithTimeIntervalSinceReferenceDate:starts[index]];
+        NSDate *end = [NSDate dateWithTimeIntervalSinceReferenceDate:ends[index]];
+        NSInteger expected = [calendar components:NSCalendarUnitDay fromDate:start toDate:end options:0].day;
+        XCTAssertEqual([start daysBetweenDate:end], expected, @"Result is not correct for %@ - %@", start, end);
+        XCTAssertEqual(days[index], expected, @"Result is not correct for %@ - %@", start, end);
+        expected = [calendar components:NSCalendarUnitMonth fromDate:start toDate:end options:0].month;
+        XCTAssertEqual([start monthsBetweenDate:end], expected, @"Result is not correct for %@ - %@", start, end);
+        XCTAssertEqual(months[index], expected, @"Result is not correct for %@ - %@", start, end);
+        expected = [calendar components:NSCalendarUnitYear fromDate:start toDate:end options:0].year;
+        XCTAssertEqual([start yearsBetweenDate:end], expected, @"Result is not correct for %@ - %@", start, end);
+        XCTAssertEqual(years[index], expected, @"Result is not correct for %@ - %@", start, end);
+    }
+    free(starts);
+    free(ends);
+    free(days);
+    free(months);
+    free(years);
+
+    @synchronized(cachedCalendar) {
+        cachedCalendar.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    }
+}
+
+- (void)test_differencesBetweenDates_monthEnds {
+    NSDate *date = [NSDate dateWithYear:2015 month:1 day:31];
+    XCTAssertEqual([date monthsBetweenDate:[NSDate dateWithYear:2015 month:2 day:28]], 1, @"Result is not correct");
+    XCTAssertEqual([date monthsBetweenDate:[NSDate dateWithYear:2015 month:2 day:27]], 0, @"Result is not correct");
+    XCTAssertEqual([date monthsBetweenDate:[NSDate dateWithYear:2014 month:12 day:31]], -1, @"Result is not correct");
+    XCTAssertEqual([date monthsBetweenDate:[NSDate dateWithYear:2015 month:1 day:1]], 0, @"Result is not correct");
+
+    date = [NSDate dateWithYear:2016 month:2 day:29];
+    XCTAssertEqual([date yearsBetweenDate:[NSDate dateWithYear:2017 month:2 day:28]], 1, @"Result is not correct");
+    XCTAssertEqual([date yearsBetweenDate:[NSDate dateWithYear:2015 month:3 day:1]], 0, @"Result is not correct");
+    XCTAssertEqual([date daysBetweenDate:[NSDate dateWithYear:2016 month:3 day:1 hour:0 minute:0 second:1]], 1, @"Result is not correct");
+    XCTAssertEqual([[date dateByAddingTimeInterval:1] daysBetweenDate:[NSDate dateWithYear:2016 month:3 day:1]], 0, @"Result is not correct");
+}
+
+
+#pragma mark - Date ranges
+
+- (void)test_enumerateDatesUntilDate {
+    NSDate *startDate = [NSDate dateWithYear:2016 month:1 day:31 hour:12 minute:0 second:0];
+    NSDate *endDate = [NSDate dateWithYear:2016 month:5 day:31];
+    __block NSInteger count = 0;
+    [startDate enumerateDatesUntilDate:endDate unit:INDateRangeUnitDay usingBlock:^(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop) {
+        XCTAssertEqual(packedDate, INPackedDateMake(2016, 1, 31 + count, 12, 0, 0), @"Result is not correct");
+        count++;
+    }];
+    XCTAssertEqual(count, 121, @"Result is not correct '%ld'", (long)count);
+
+    NSArray *expectedDays = @[@31, @29, @31, @30];
+    __block NSMutableArray *days = [NSMutableArray array];
+    [startDate enumerateDatesUntilDate:endDate unit:INDateRangeUnitMonth usingBlock:^(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop) {
+        XCTAssertEqual(dateInfo.hour, 12, @"Result is not correct '%ld'", (long)dateInfo.hour);
+        [days addObject:@(dateInfo.day)];
+    }];
+    // the 31st May 12:00 is after the end date
+    XCTAssertEqualObjects(days, expectedDays, @"Result is not correct '%@'", days);
+
+    count = 0;
+    [startDate enumerateDatesUntilDate:endDate unit:INDateRangeUnitWeek usingBlock:^(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop) {
+        XCTAssertEqual(dateInfo.weekday, 1, @"Result is not correct '%ld'", (long)dateInfo.weekday);
+        count++;
+        *stop = count == 3;
+    }];
+    XCTAssertEqual(count, 3, @"Result is not correct '%ld'", (long)count);
+
+    count = 0;
+    [endDate enumerateDatesUntilDate:startDate unit:INDateRangeUnitDay usingBlock:^(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop) {
+        count++;
+    }];
+    XCTAssertEqual(count, 0, @"Result is not correct '%ld'", (long)count);
+}
+
+- (void)test_dateRange_fastEnumeration {
+    NSDate *startDate = [NSDate dateWithYear:2000 month:1 day:1];
+    NSDate *endDate = [NSDate dateWithYear:2009 month:12 day:31];
+    INDateRange *range = [startDate dateRangeUntilDate:endDate unit:INDateRangeUnitDay];
+    NSInteger count = 0;
+    for (NSNumber *number in range) {
+        XCTAssertEqual([number longLongValue], INPackedDateMake(2000, 1, 1 + count, 0, 0, 0), @"Result is not correct");
+        count++;
+    }
+    XCTAssertEqual(count, 3653, @"Result is not correct '%ld'", (long)count);
+
+    range = [INDateRange rangeWithStartDate:INPackedDateMake(2000, 2, 29, 0, 0, 0) endDate:INPackedDateMake(2004, 2, 29, 0, 0, 0) unit:INDateRangeUnitYear];
+    NSMutableArray *days = [NSMutableArray array];
+    for (NSNumber *number in range) {
+        [days addObject:@(INDateInformationFromPackedDate([number longLongValue]).day)];
+    }
+    NSArray *expected = @[@29, @28, @28, @28, @29];
+    XCTAssertEqualObjects(days, expected, @"Result is not correct '%@'", days);
+}
+
+
 @end
@@ -106,6 +106,58 @@
     XCTAssert([result isEqualToString:expect], @"'%@' was expected, but is '%@'", expect, result);
 }
 
+- (void)test_stringTrimmed_onNonTrimmableString_returnsReceiver {
+    NSString *string = [NSString stringWithFormat:@"%@ %d", @"don't trimm me", 1];
+    XCTAssertEqual([string stringTrimmed], string, @"The string itself was expected");
+
+    NSMutableString *mutableString = [NSMutableString stringWithString:@"don't trimm me"];
+    NSString *result = [mutableString stringTrimmed];
+    [mutableString appendString:@" changed"];
+    XCTAssert([result isEqualToString:@"don't trimm me"], @"A mutable string should be copied, but is '%@'", result);
+}
+
+- (void)test_stringTrimmed_matchesTrimmingCharactersInSet {
+    NSCharacterSet *whitespaces = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+    unichar characters[] = {' ', '\t', '\n', '\r', 0x0b, 0x0c, 0x85, 0xa0, 0x2003, 0x3000, 'a', 'Z', 0xfc, 0x20ac, '.', 0xd83d, 0xde00};
+    NSUInteger characterCount = sizeof(characters) / sizeof(characters[0]);
+    srand48(18);
+    for (NSInteger index = 0; index < 2000; index++) {
+        // long strings exceed the inline buffer of the scanner
+        NSUInteger length = (NSUInteger)(drand48() * (index % 10 == 0 ? 300 : 12));
+        NSMutableString *string = [NSMutableString string];
+        for (NSUInteger position = 0; position < length; position++) {
+            // mostly whitespaces for long runs to trim
+            unichar character = characters[drand48() < 0.8 ? lrand48() % 10 : lrand48() % characterCount];
+            [string appendFormat:@"%C", character];
+        }
+        NSString *expected = [string stringByTrimmingCharactersInSet:whitespaces];
+        NSString *result = [string stringTrimmed];
+        XCTAssertEqualObjects(result, expected, @"Result is not correct for '%@'", string);
+        XCTAssertEqual([string hasText], expected.length > 0, @"Result is not correct for '%@'", string);
+    }
+}
+
+- (void)test_performance_stringTrimmed {
+    NSUInteger count = 100000;
+    NSArray *strings = @[@"plain value", @"  padded value \n", @" non-breaking ", @"", @"    "];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger trimmingLength = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        trimmingLength += [strings[index % strings.count] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]].length;
+    }
+    CFAbsoluteTime trimmingTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger length = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        length += [strings[index % strings.count] stringTrimmed].length;
+    }
+    CFAbsoluteTime trimmedTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(length, trimmingLength, @"Result is not correct");
+    NSLog(@"stringByTrimmingCharactersInSet: %.0f strings/s, stringTrimmed: %.0f strings/s", count / trimmingTime, count / trimmedTime);
+}
+
 
 #pragma mark - firstCharacter
 
@@ -189,6 +241,92 @@
 }
 
 
+- (void)test_isEqualToCaseInsensitiveString_onRandomStrings_matchesCompare {
+    NSString *characters = @"aAbBzZ@[`{09 _ßÄäǅ\u0301";
+    srand48(19);
+    for (NSUInteger index = 0; index < 2000; index++) {
+        NSUInteger length = lrand48() % 70;
+        unichar buffer[70];
+        unichar otherBuffer[70];
+        for (NSUInteger position = 0; position < length; position++) {
+            // mostly ASCII, sometimes non ASCII characters to leave the fast path
+            NSUInteger characterCount = drand48() < 0.95 ? 14 : characters.length;
+            buffer[position] = [characters characterAtIndex:lrand48() % characterCount];
+            unichar character = buffer[position];
+            otherBuffer[position] = drand48() < 0.02 ? [characters characterAtIndex:lrand48() % characters.length] : (unichar)(character >= 'a' && character <= 'z' ? character - 0x20 : character);
+        }
+        NSString *string = [NSString stringWithCharacters:buffer length:length];
+        NSString *other = [NSString stringWithCharacters:otherBuffer length:length - (drand48() < 0.1 && length > 0 ? 1 : 0)];
+        BOOL expected = [string compare:other options:NSCaseInsensitiveSearch] == NSOrderedSame;
+        XCTAssertEqual([string isEqualToCaseInsensitiveString:other], expected, @"Result is not correct for '%@' and '%@'", string, other);
+        BOOL expectedPrefix = [string rangeOfString:other options:NSCaseInsensitiveSearch | NSAnchoredSearch].location != NSNotFound || other.length == 0;
+        XCTAssertEqual([string hasCaseInsensitivePrefix:other], expectedPrefix, @"Result is not correct for '%@' and '%@'", string, other);
+    }
+}
+
+- (void)test_performance_isEqualToCaseInsensitiveString {
+    NSUInteger count = 100000;
+    NSArray *strings = @[@"Content-Type", @"content-type", @"application/json; charset=utf-8", @"APPLICATION/JSON; CHARSET=UTF-8", @"Überschrift", @"überschrift"];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger compareCount = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        NSString *string = strings[index % strings.count];
+        NSString *other = strings[(index / strings.count) % strings.count];
+        compareCount += [string compare:other options:NSCaseInsensitiveSearch] == NSOrderedSame;
+    }
+    CFAbsoluteTime compareTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger equalCount = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        NSString *string = strings[index % strings.count];
+        NSString *other = strings[(index / strings.count) % strings.count];
+        equalCount += [string isEqualToCaseInsensitiveString:other];
+    }
+    CFAbsoluteTime equalTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(equalCount, compareCount, @"Result is not correct");
+    NSLog(@"compare:options: %.0f comparisons/s, isEqualToCaseInsensitiveString: %.0f comparisons/s", count / compareTime, count / equalTime);
+}
+
+
+#pragma mark - hasCaseInsensitivePrefix:
+
+- (void)test_hasCaseInsensitivePrefix_withPrefix_returnsTrue {
+    NSString *string = @"Content-Type";
+    NSString *prefix = @"content-";
+    BOOL result = [string hasCaseInsensitivePrefix:prefix];
+    XCTAssert(result, @"'%@' was expected to begin with '%@'", string, prefix);
+
+    string = @"Überschrift";
+    prefix = @"üBER";
+    result = [string hasCaseInsensitivePrefix:prefix];
+    XCTAssert(result, @"'%@' was expected to begin with '%@'", string, prefix);
+
+    string = @"a String";
+    prefix = @"";
+    result = [string hasCaseInsensitivePrefix:prefix];
+    XCTAssert(result, @"'%@' was expected to begin with '%@'", string, prefix);
+}
+
+- (void)test_hasCaseInsensitivePrefix_withoutPrefix_returnsFalse {
+    NSString *string = @"Content";
+    NSString *prefix = @"content-type";
+    BOOL result = [string hasCaseInsensitivePrefix:prefix];
+    XCTAssert(!result, @"'%@' was expected not to begin with '%@'", string, prefix);
+
+    string = @"e\u0301clair";
+    prefix = @"E";
+    result = [string hasCaseInsensitivePrefix:prefix];
+    XCTAssert(!result, @"'%@' was expected not to begin with '%@'", string, prefix);
+
+    string = @"a String";
+    prefix = nil;
+    result = [string hasCaseInsensitivePrefix:prefix];
+    XCTAssert(!result, @"'%@' was expected not to begin with '%@'", string, prefix);
+}
+
+
 #pragma mark - firstCharacterEquals:
 
 - (void)test_firstCharacterEquals_withSameFirstCharacter_returnsTrue {
@@ -223,6 +361,11 @@
     firstChar = @"a";
     result = [string firstCharacterEquals:firstChar];
     XCTAssert(!result, @"'%@' was expected not to begin with '%@'", string, firstChar);
+
+    string = @"a String";
+    firstChar = nil;
+    result = [string firstCharacterEquals:firstChar];
+    XCTAssert(!result, @"'%@' was expected not to begin with '%@'", string, firstChar);
 }
 
 
@@ -404,6 +547,75 @@
 }
 
 
+- (void)test_versionComparison_withInvalidVersions_comparesNumerically {
+    XCTAssert([@"1.2b" versionLowerThan:@"1.10"], @"was expected to be true");
+    XCTAssert([@"1.2" versionEqualTo:@"1.02"], @"was expected to be true");
+    XCTAssert([@"1.2.x" versionHigherThan:@"1.2"], @"was expected to be true");
+}
+
+- (void)test_versionComparison_matchesNumericComparison {
+    srand48(16);
+    for (NSInteger index = 0; index < 2000; index++) {
+        NSMutableArray *components = [NSMutableArray array];
+        NSMutableArray *otherComponents = [NSMutableArray array];
+        for (NSInteger component = lrand48() % 5; component >= 0; component--) {
+            [components addObject:@(lrand48() % 12)];
+        }
+        for (NSInteger component = lrand48() % 5; component >= 0; component--) {
+            [otherComponents addObject:@(lrand48() % 12)];
+        }
+        NSString *version = [components componentsJoinedByString:@"."];
+        NSString *otherVersion = [otherComponents componentsJoinedByString:@"."];
+        NSString *string1 = [version versionStringWithLength:otherComponents.count];
+        NSString *string2 = [otherVersion versionStringWithLength:components.count];
+        NSComparisonResult expected = [string1 compare:string2 options:NSNumericSearch];
+        XCTAssertEqual([version versionLowerThan:otherVersion], expected == NSOrderedAscending, @"Result is not correct for %@ and %@", version, otherVersion);
+        XCTAssertEqual([version versionEqualTo:otherVersion], expected == NSOrderedSame, @"Result is not correct for %@ and %@", version, otherVersion);
+        XCTAssertEqual([version versionHigherThan:otherVersion], expected == NSOrderedDescending, @"Result is not correct for %@ and %@", version, otherVersion);
+    }
+}
+
+
+#pragma mark - INVersion
+
+- (void)test_INVersionParseString {
+    INVersion version;
+    XCTAssert(INVersionParseString(@"1.22.333", &version), @"was expected to be true");
+    XCTAssert(version.count == 3 && version.components[0] == 1 && version.components[1] == 22 && version.components[2] == 333 && version.components[3] == 0, @"Result is not correct");
+    XCTAssert(INVersionParseString(@"", &version) && version.count == 0, @"was expected to be true");
+    XCTAssert(INVersionParseString([NSString stringWithFormat:@"%@.%d", @"4294967295", 1], &version), @"was expected to be true");
+    NSArray *invalidStrings = @[@"1.", @".1", @"1..2", @"1.2b", @" 1", @"4294967296", @"1.2.3.4.5.6.7.8.9", @"1·2"];
+    for (NSString *string in invalidStrings) {
+        XCTAssert(!INVersionParseString(string, &version), @"'%@' was expected to be invalid", string);
+    }
+    XCTAssert(!INVersionParseString(nil, &version), @"was expected to be false");
+}
+
+- (void)test_INVersionCompare {
+    INVersion version, otherVersion;
+    INVersionParseString(@"1.2", &version);
+    INVersionParseString(@"1.2.0", &otherVersion);
+    XCTAssertEqual(INVersionCompare(version, otherVersion), NSOrderedSame, @"Result is not correct");
+    XCTAssert(INVersionIsEqual(version, otherVersion), @"was expected to be true");
+    XCTAssertEqual(INVersionHash(version), INVersionHash(otherVersion), @"Equal versions should have equal hashes");
+    INVersionParseString(@"1.10", &otherVersion);
+    XCTAssertEqual(INVersionCompare(version, otherVersion), NSOrderedAscending, @"Result is not correct");
+    XCTAssertEqual(INVersionCompare(otherVersion, version), NSOrderedDescending, @"Result is not correct");
+    XCTAssertEqual(INVersionCompare(INVersionMake(2, 0, 0), version), NSOrderedDescending, @"Result is not correct");
+}
+
+- (void)test_INVersionIncreasedAtIndex {
+    INVersion version;
+    INVersionParseString(@"1.2.3", &version);
+    XCTAssertEqualObjects(INVersionString(INVersionIncreasedAtIndex(version, 2)), @"1.2.4", @"Result is not correct");
+    XCTAssertEqualObjects(INVersionString(INVersionIncreasedAtIndex(version, 1)), @"1.3", @"Result is not correct");
+    XCTAssertEqualObjects(INVersionString(INVersionIncreasedAtIndex(version, 0)), @"2", @"Result is not correct");
+    INVersionParseString(@"1", &version);
+    XCTAssertEqualObjects(INVersionString(INVersionIncreasedAtIndex(version, 2)), @"1.0.1", @"Result is not correct");
+    XCTAssertEqualObjects(INVersionString(INVersionIncreasedAtIndex(version, INVersionMaximumComponents)), @"1", @"Result is not correct");
+}
+
+
 #pragma mark - versionStringIncreasedAtIndex:
 
 - (void)test_versionStringIncreasedAtIndex {
@@ -468,4 +680,194 @@
 }
 
 
+#pragma mark - INVersionConstraint
+
+- (void)test_INVersionConstraint_matchesVersionString {
+    NSDictionary *cases = @{
+        @">=1.2 <2.0 || ~3.1": @[@[@"1.2", @"1.9.9", @"3.1", @"3.1.7"], @[@"1.1.9", @"2", @"3.0", @"3.2", @"beta"]],
+        @"1.2": @[@[@"1.2", @"1.2.0"], @[@"1.2.1", @"1"]],
+        @"!=1.2 >1": @[@[@"1.1", @"1.3"], @[@"1.2.0", @"1"]],
+        @"<= 2.0": @[@[@"2", @"0.1"], @[@"2.0.1"]],
+        @"~1": @[@[@"1", @"1.9"], @[@"2", @"0.9"]],
+        @"^1.2.3": @[@[@"1.2.3", @"1.99"], @[@"1.2.2", @"2.0"]],
+        @"^0.2.3": @[@[@"0.2.3", @"0.2.9"], @[@"0.3", @"0.2.2"]],
+        @"^0.0.3": @[@[@"0.0.3"], @[@"0.0.4", @"0.0.2"]],
+        @"1.2.x||2.*": @[@[@"1.2", @"1.2.5", @"2.7"], @[@"1.3", @"3"]],
+        @"* || 1.0": @[@[@"0", @"42.1"], @[]],
+    };
+    for (NSString *expression in cases) {
+        INVersionConstraint *constraint = [INVersionConstraint constraintWithString:expression];
+        XCTAssertNotNil(constraint, @"'%@' was expected to be valid", expression);
+        for (NSString *version in cases[expression][0]) {
+            XCTAssert([constraint matchesVersionString:version], @"'%@' was expected to match '%@'", version, expression);
+        }
+        for (NSString *version in cases[expression][1]) {
+            XCTAssert(![constraint matchesVersionString:version], @"'%@' was expected not to match '%@'", version, expression);
+        }
+    }
+}
+
+- (void)test_INVersionConstraint_withInvalidExpressions_returnsNil {
+    NSArray *expressions = @[@"", @"||", @"1.0 ||", @">=", @">=1.x", @"~", @"1.x.2", @"1.2b", @"=> 1.0"];
+    for (NSString *expression in expressions) {
+        XCTAssertNil([INVersionConstraint constraintWithString:expression], @"'%@' was expected to be invalid", expression);
+    }
+    XCTAssertNil([INVersionConstraint constraintWithString:nil], @"nil was expected to be invalid");
+}
+
+- (void)test_INVersionConstraint_filteredVersionStrings {
+    INVersionConstraint *constraint = [INVersionConstraint constraintWithString:@">=1.2 <2"];
+    NSArray *result = [constraint filteredVersionStrings:@[@"1.1", @"1.2", @"beta", @5, @"1.10", @"2.0"]];
+    NSArray *expected = @[@"1.2", @"1.10"];
+    XCTAssertEqualObjects(result, expected, @"Result is not correct '%@'", result);
+
+    INVersion versions[3] = {INVersionMake(1, 1, 0), INVersionMake(1, 5, 0), INVersionMake(2, 0, 0)};
+    NSIndexSet *indexes = [constraint indexesOfVersionsMatching:versions count:3];
+    XCTAssertEqualObjects(indexes, [NSIndexSet indexSetWithIndex:1], @"Result is not correct '%@'", indexes);
+}
+
+#pragma mark - INStringIndex
+
+- (void)test_INStringIndex_indexOfString_returnsLowestIndex {
+    INStringIndex *index = [INStringIndex indexWithStrings:@[@"Berlin", @"Bern", @"Bonn", @"BERLIN", @"Straße", @"Ärger"]];
+    NSUInteger result = [index indexOfString:@"bonn"];
+    XCTAssertEqual(result, (NSUInteger)2, @"Result is not correct '%lu'", (unsigned long)result);
+
+    result = [index indexOfString:@"berlin"];
+    XCTAssertEqual(result, (NSUInteger)0, @"Result is not correct '%lu'", (unsigned long)result);
+
+    result = [index indexOfString:@"STRASSE"];
+    XCTAssertEqual(result, (NSUInteger)4, @"Result is not correct '%lu'", (unsigned long)result);
+
+    result = [index indexOfString:@"ärger"];
+    XCTAssertEqual(result, (NSUInteger)5, @"Result is not correct '%lu'", (unsigned long)result);
+
+    result = [index indexOfString:@"Ber"];
+    XCTAssertEqual(result, (NSUInteger)NSNotFound, @"Result is not correct '%lu'", (unsigned long)result);
+
+    NSIndexSet *indexes = [index indexesOfString:@"Berlin"];
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:0];
+    [expected addIndex:3];
+    XCTAssertEqualObjects(indexes, expected, @"Result is not correct '%@'", indexes);
+    XCTAssert(![index containsString:nil], @"nil was expected not to be found");
+}
+
+- (void)test_INStringIndex_stringsWithPrefix_returnsCompletions {
+    INStringIndex *index = [INStringIndex indexWithStrings:@[@"Bernau", @"Berlin", @"Bonn", @"Bern", @"Aachen"]];
+    NSArray *result = [index stringsWithPrefix:@"BER" limit:10];
+    NSArray *expected = @[@"Berlin", @"Bern", @"Bernau"];
+    XCTAssertEqualObjects(result, expected, @"Result is not correct '%@'", result);
+
+    result = [index stringsWithPrefix:@"b" limit:2];
+    expected = @[@"Berlin", @"Bern"];
+    XCTAssertEqualObjects(result, expected, @"Result is not correct '%@'", result);
+
+    NSUInteger count = [index countOfStringsWithPrefix:@""];
+    XCTAssertEqual(count, (NSUInteger)5, @"Result is not correct '%lu'", (unsigned long)count);
+
+    count = [index countOfStringsWithPrefix:@"Berne"];
+    XCTAssertEqual(count, (NSUInteger)0, @"Result is not correct '%lu'", (unsigned long)count);
+
+    NSIndexSet *indexes = [index indexesOfStringsWithPrefix:@"bern"];
+    NSMutableIndexSet *expectedIndexes = [NSMutableIndexSet indexSetWithIndex:0];
+    [expectedIndexes addIndex:3];
+    XCTAssertEqualObjects(indexes, expectedIndexes, @"Result is not correct '%@'", indexes);
+
+    NSMutableArray *enumerated = [NSMutableArray array];
+    [index enumerateStringsWithPrefix:@"b" usingBlock:^(NSString *string, NSUInteger stringIndex, BOOL *stop) {
+        [enumerated addObject:string];
+        *stop = enumerated.count == 3;
+    }];
+    expected = @[@"Berlin", @"Bern", @"Bernau"];
+    XCTAssertEqualObjects(enumerated, expected, @"Result is not correct '%@'", enumerated);
+}
+
+- (void)test_INStringIndex_withDecomposedCharacters_matchesPrecomposed {
+    NSString *precomposed = @"Caf\u00E9";
+    NSString *decomposed = @"Cafe\u0301";
+    XCTAssert([decomposed isEqualToCaseInsensitiveString:precomposed], @"The strings were expected to be equal");
+
+    INStringIndex *index = [INStringIndex indexWithStrings:@[@"Cafe", decomposed, @"\u00C4rger"]];
+    NSUInteger result = [index indexOfString:@"CAF\u00C9"];
+    XCTAssertEqual(result, (NSUInteger)1, @"Result is not correct '%lu'", (unsigned long)result);
+
+    index = [INStringIndex indexWithStrings:@[@"Cafe", precomposed, @"A\u0308rger"]];
+    result = [index indexOfString:@"cafe\u0301"];
+    XCTAssertEqual(result, (NSUInteger)1, @"Result is not correct '%lu'", (unsigned long)result);
+
+    result = [index indexOfString:@"\u00E4rger"];
+    XCTAssertEqual(result, (NSUInteger)2, @"Result is not correct '%lu'", (unsigned long)result);
+
+    NSArray *completions = [index stringsWithPrefix:@"caf\u00E9" limit:10];
+    NSArray *expected = @[precomposed];
+    XCTAssertEqualObjects(completions, expected, @"Result is not correct '%@'", completions);
+
+    // the combining mark belongs to the prefix's last character, so the string doesn't start with the prefix
+    NSUInteger count = [index countOfStringsWithPrefix:@"cafe"];
+    XCTAssertEqual(count, (NSUInteger)1, @"Result is not correct '%lu'", (unsigned long)count);
+
+    count = [index countOfStringsWithPrefix:@"a"];
+    XCTAssertEqual(count, (NSUInteger)0, @"Result is not correct '%lu'", (unsigned long)count);
+}
+
+- (void)test_INStringIndex_onRandomStrings_matchesLinearSearch {
+    NSString *characters = @"aAbBcC -Ää";
+    srand48(20);
+    NSMutableArray *strings = [NSMutableArray array];
+    for (NSUInteger index = 0; index < 500; index++) {
+        NSMutableString *string = [NSMutableString string];
+        NSUInteger length = lrand48() % 6;
+        for (NSUInteger position = 0; position < length; position++) {
+            [string appendFormat:@"%C", [characters characterAtIndex:lrand48() % characters.length]];
+        }
+        [strings addObject:string];
+    }
+    INStringIndex *index = [INStringIndex indexWithStrings:strings];
+    for (NSUInteger searchIndex = 0; searchIndex < 100; searchIndex++) {
+        NSString *search = [strings[lrand48() % strings.count] uppercaseString];
+        NSUInteger expected = [strings indexOfObjectPassingTest:^BOOL(NSString *string, NSUInteger stringIndex, BOOL *stop) {
+            return [string isEqualToCaseInsensitiveString:search];
+        }];
+        XCTAssertEqual([index indexOfString:search], expected, @"Result is not correct for '%@'", search);
+        NSIndexSet *expectedIndexes = [strings indexesOfObjectsPassingTest:^BOOL(NSString *string, NSUInteger stringIndex, BOOL *stop) {
+            return [string hasCaseInsensitivePrefix:search];
+        }];
+        XCTAssertEqualObjects([index indexesOfStringsWithPrefix:search], expectedIndexes, @"Result is not correct for '%@'", search);
+    }
+}
+
+- (void)test_performance_INStringIndex {
+    NSUInteger count = 100000;
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [strings addObject:[NSString stringWithFormat:@"Name %lu", (unsigned long)(index * 7919 % count)]];
+    }
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    INStringIndex *index = [INStringIndex indexWithStrings:strings];
+    CFAbsoluteTime buildTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    NSUInteger lookups = 100;
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger scanSum = 0;
+    for (NSUInteger lookup = 0; lookup < lookups; lookup++) {
+        NSString *search = [NSString stringWithFormat:@"NAME %lu", (unsigned long)(lookup * 997)];
+        scanSum += [strings indexOfObjectPassingTest:^BOOL(NSString *string, NSUInteger stringIndex, BOOL *stop) {
+            return [string isEqualToCaseInsensitiveString:search];
+        }];
+    }
+    CFAbsoluteTime scanTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger indexSum = 0;
+    for (NSUInteger lookup = 0; lookup < lookups; lookup++) {
+        NSString *search = [NSString stringWithFormat:@"NAME %lu", (unsigned long)(lookup * 997)];
+        indexSum += [index indexOfString:search];
+    }
+    CFAbsoluteTime indexTime = CFAbsoluteTimeGetCurrent() - startTime;
+
+    XCTAssertEqual(indexSum, scanSum, @"Result is not correct");
+    NSLog(@"INStringIndex built in %.3fs, linear scan: %.0f lookups/s, index: %.0f lookups/s", buildTime, lookups / scanTime, lookups / indexTime);
+}
+
+
 @end
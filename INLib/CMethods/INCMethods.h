@@ -21,5 +21,9 @@
 // THE SOFTWARE.
 
 
+#import "INDateArithmetic.h"
 #import "INDirectories.h"
 #import "INRoundingFunctions.h"
+#import "INWeekRule.h"
+#import "INVersion.h"
+#import "INConcurrentChunks.h"
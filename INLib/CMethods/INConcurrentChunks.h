@@ -0,0 +1,74 @@
+// INConcurrentChunks.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ The division of a number of elements into chunks of consecutive elements, which are processed by several threads.
+
+ There are more chunks than threads, each thread takes the next unprocessed chunk when done, so slow chunks don't hold up the others.
+ */
+typedef struct INChunks {
+    /// the number of elements
+    NSUInteger count;
+    /// the number of threads processing the chunks, 1 if the chunks are processed on the calling thread
+    NSUInteger threadCount;
+    /// the number of elements of each chunk, only the last chunk may be shorter
+    NSUInteger chunkSize;
+    /// the number of chunks, 0 if there are no elements
+    NSUInteger chunkCount;
+} INChunks;
+
+
+/**
+ Returns the chunks for a number of elements.
+
+ Fewer elements than the threshold are processed as one chunk on the calling thread, the thread dispatching and synchronizing would cost more than it saves.
+ Otherwise there are eight chunks for each thread, but each chunk has at least 64 elements, so taking a chunk costs little compared to processing it.
+
+ @param count The number of elements.
+ @param threshold The number of elements from which on the chunks are processed concurrently.
+ @param maximumThreads The maximum number of threads or 0 for the number of active processors.
+ @return The chunks to pass to INChunksEnumerate().
+ */
+INChunks INChunksMake(NSUInteger count, NSUInteger threshold, NSUInteger maximumThreads);
+
+/**
+ Calls the block for each chunk until all chunks are processed or the block has set stop.
+
+ The chunks are taken in order by the next free thread, each concurrently processed chunk has its own autorelease pool.
+ The function returns after all started chunks have been processed. The block has to be safe to call from several threads at the same time.
+
+ @param chunks The chunks created by INChunksMake().
+ @param block The block called for each chunk with the range of the chunk's elements and the chunk's index, set stop to true to skip all chunks not yet started.
+ */
+void INChunksEnumerate(INChunks chunks, void (^block)(NSRange range, NSUInteger chunk, BOOL *stop));
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,81 @@
+// INConcurrentChunks.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "INConcurrentChunks.h"
+#import <stdatomic.h>
+
+
+// the number of chunks for each thread, so threads finishing early can take over more work
+static const NSUInteger INChunksPerThread = 8;
+
+// the minimum number of elements of a chunk, so taking a chunk costs little compared to processing it
+static const NSUInteger INChunksMinimumSize = 64;
+
+
+INChunks INChunksMake(NSUInteger count, NSUInteger threshold, NSUInteger maximumThreads) {
+    INChunks chunks;
+    chunks.count = count;
+    chunks.threadCount = maximumThreads > 0 ? maximumThreads : [[NSProcessInfo processInfo] activeProcessorCount];
+    if (count < threshold || chunks.threadCount < 2) {
+        chunks.threadCount = 1;
+        chunks.chunkSize = MAX(count, 1);
+    } else {
+        NSUInteger chunkCount = chunks.threadCount * INChunksPerThread;
+        chunks.chunkSize = MAX((count + chunkCount - 1) / chunkCount, INChunksMinimumSize);
+    }
+    chunks.chunkCount = (count + chunks.chunkSize - 1) / chunks.chunkSize;
+    return chunks;
+}
+
+void INChunksEnumerate(INChunks chunks, void (^block)(NSRange range, NSUInteger chunk, BOOL *stop)) {
+    if (chunks.threadCount < 2) {
+        BOOL stop = NO;
+        for (NSUInteger chunk = 0; chunk < chunks.chunkCount && !stop; chunk++) {
+            NSUInteger start = chunk * chunks.chunkSize;
+            block(NSMakeRange(start, MIN(chunks.chunkSize, chunks.count - start)), chunk, &stop);
+        }
+        return;
+    }
+
+    // dispatch_apply returns when all threads are done, so the counters on the stack live long enough
+    atomic_size_t nextChunk = 0;
+    atomic_bool stopped = false;
+    atomic_size_t *nextChunkPointer = &nextChunk;
+    atomic_bool *stoppedPointer = &stopped;
+    dispatch_apply(chunks.threadCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+        while (!atomic_load_explicit(stoppedPointer, memory_order_relaxed)) {
+            NSUInteger chunk = atomic_fetch_add_explicit(nextChunkPointer, 1, memory_order_relaxed);
+            if (chunk >= chunks.chunkCount) {
+                break;
+            }
+            NSUInteger start = chunk * chunks.chunkSize;
+            BOOL stop = NO;
+            @autoreleasepool {
+                block(NSMakeRange(start, MIN(chunks.chunkSize, chunks.count - start)), chunk, &stop);
+            }
+            if (stop) {
+                atomic_store_explicit(stoppedPointer, true, memory_order_relaxed);
+            }
+        }
+    });
+}
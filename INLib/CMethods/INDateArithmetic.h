@@ -0,0 +1,318 @@
+// INDateArithmetic.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ The number of seconds of one day without any daylight saving time shifts.
+ */
+static const NSInteger INDateSecondsPerDay = 86400;
+
+
+/**
+ The first day of the gregorian calendar, the 15th October 1582, as days since the 1st January 1970.
+
+ NSCalendar's gregorian calendar switches to the julian calendar for all days before this one,
+ so the arithmetic functions only return the same results as NSCalendar for days on or after this day.
+ */
+static const NSInteger INDateGregorianCutoverDay = -141427;
+
+
+/**
+ The 1st January 10000 as days since the 1st January 1970, the first day which is not supported by the arithmetic functions anymore.
+ */
+static const NSInteger INDateArithmeticMaximumDay = 2932897;
+
+
+/**
+ Divides two integers and rounds the result towards negative infinity.
+
+    INDateFloorDivide(7, 2) = 3
+    INDateFloorDivide(-7, 2) = -4
+
+ @param dividend The value to divide.
+ @param divisor The positive value to divide by.
+ @return The floored quotient.
+ */
+static inline int64_t INDateFloorDivide(int64_t dividend, int64_t divisor) {
+    int64_t quotient = dividend / divisor;
+    if (quotient * divisor > dividend) {
+        quotient--;
+    }
+    return quotient;
+}
+
+
+/**
+ Returns true if the given year is a leap year in the gregorian calendar.
+
+ @param year The year, i.e. 2016.
+ @return True for leap years, otherwise false.
+ */
+static inline BOOL INDateIsLeapYear(NSInteger year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+
+/**
+ Converts a gregorian date into the number of days since the 1st January 1970.
+
+ The calculation uses the proleptic gregorian calendar, so no calendar object and no lock is needed.
+ The month and day have to be valid for the given year.
+ See [chrono-Compatible Low-Level Date Algorithms](http://howardhinnant.github.io/date_algorithms.html) for the algorithm.
+
+    INDateDaysFromCivil(1970, 1, 1) = 0
+    INDateDaysFromCivil(2000, 3, 1) = 11017
+
+ @param year The year.
+ @param month The month, 1..12.
+ @param day The day of the month, 1..31.
+ @return The number of days since the 1st January 1970, negative for days before.
+ */
+static inline NSInteger INDateDaysFromCivil(NSInteger year, NSInteger month, NSInteger day) {
+    year -= month <= 2;
+    NSInteger era = (year >= 0 ? year : year - 399) / 400;
+    NSInteger yearOfEra = year - era * 400;
+    NSInteger dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    NSInteger dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+
+/**
+ Converts the number of days since the 1st January 1970 into a gregorian date.
+
+ This is the inverse function of INDateDaysFromCivil().
+
+ @param days The number of days since the 1st January 1970.
+ @param year On return the year.
+ @param month On return the month, 1..12.
+ @param day On return the day of the month, 1..31.
+ */
+static inline void INDateCivilFromDays(NSInteger days, NSInteger *year, NSInteger *month, NSInteger *day) {
+    days += 719468;
+    NSInteger era = (days >= 0 ? days : days - 146096) / 146097;
+    NSInteger dayOfEra = days - era * 146097;
+    NSInteger yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    NSInteger dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    NSInteger shiftedMonth = (5 * dayOfYear + 2) / 153;
+    *day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    *month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    *year = yearOfEra + era * 400 + (*month <= 2);
+}
+
+
+/**
+ Returns the weekday for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @return The weekday as used by NSCalendar: Sunday = 1, Monday = 2, ..., Saturday = 7
+ */
+static inline NSInteger INDateWeekdayFromDays(NSInteger days) {
+    // the 1st January 1970 was a Thursday
+    return (NSInteger)(days + 4 - INDateFloorDivide(days + 4, 7) * 7) + 1;
+}
+
+
+/**
+ Returns the day number of the year for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @param year The year of the day, which has to be calculated before by INDateCivilFromDays().
+ @return The day of the year, 1..366.
+ */
+static inline NSInteger INDateDayOfYearFromDays(NSInteger days, NSInteger year) {
+    return days - INDateDaysFromCivil(year, 1, 1) + 1;
+}
+
+
+/**
+ Returns the number of days of a month in the gregorian calendar.
+
+ The lengths are looked up in a table, so no calendar object is needed.
+
+    INDateDaysInMonth(2016, 2) = 29
+    INDateDaysInMonth(2015, 4) = 30
+
+ @param year The year.
+ @param month The month, 1..12.
+ @return The number of days of the month, 28..31.
+ */
+static inline NSInteger INDateDaysInMonth(NSInteger year, NSInteger month) {
+    static const uint8_t daysInMonth[2][12] = {
+        {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+        {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}
+    };
+    return daysInMonth[INDateIsLeapYear(year) ? 1 : 0][month - 1];
+}
+
+
+/**
+ Returns the first day of the month for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @return The first day of the same month as days since the 1st January 1970.
+ */
+static inline NSInteger INDateFirstOfMonthFromDays(NSInteger days) {
+    NSInteger year, month, day;
+    INDateCivilFromDays(days, &year, &month, &day);
+    return days - day + 1;
+}
+
+
+/**
+ Returns the last day of the month for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @return The last day of the same month as days since the 1st January 1970.
+ */
+static inline NSInteger INDateLastOfMonthFromDays(NSInteger days) {
+    NSInteger year, month, day;
+    INDateCivilFromDays(days, &year, &month, &day);
+    return days - day + INDateDaysInMonth(year, month);
+}
+
+
+/**
+ Returns the first day of the year for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @return The 1st January of the same year as days since the 1st January 1970.
+ */
+static inline NSInteger INDateFirstOfYearFromDays(NSInteger days) {
+    NSInteger year, month, day;
+    INDateCivilFromDays(days, &year, &month, &day);
+    return INDateDaysFromCivil(year, 1, 1);
+}
+
+
+/**
+ Adds an amount of months to the number of days since the 1st January 1970.
+
+ The day of the month is kept, but limited to the last day of the resulting month, i.e. the 31st January plus one month is the 28th or 29th February.
+
+ @param days The number of days since the 1st January 1970.
+ @param months The months to add, may be negative.
+ @param clamped On return true if the day of the month had to be limited to the month's last day, may be NULL.
+ @return The resulting day as days since the 1st January 1970.
+ */
+static inline NSInteger INDateDaysByAddingMonths(NSInteger days, NSInteger months, BOOL *clamped) {
+    NSInteger year, month, day;
+    INDateCivilFromDays(days, &year, &month, &day);
+    NSInteger monthIndex = year * 12 + month - 1 + months;
+    year = (NSInteger)INDateFloorDivide(monthIndex, 12);
+    month = monthIndex - year * 12 + 1;
+    NSInteger daysInMonth = INDateDaysInMonth(year, month);
+    if (clamped != NULL) {
+        *clamped = day > daysInMonth;
+    }
+    return INDateDaysFromCivil(year, month, MIN(day, daysInMonth));
+}
+
+
+/**
+ Returns the first day of the week for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @param firstWeekday The first day of the week (1=Sun, 2=Mon, ...).
+ @return The first day of the week as days since the 1st January 1970, which is the same or an earlier day.
+ */
+static inline NSInteger INDateWeekstartFromDays(NSInteger days, NSInteger firstWeekday) {
+    return days - (INDateWeekdayFromDays(days) - firstWeekday + 7) % 7;
+}
+
+
+/**
+ Converts a gregorian date and time into the seconds since the 1st January 1970 00:00:00 in the same time zone.
+
+ Like NSCalendar the fields may exceed their ranges, i.e. the month 13 is the January of the next year and the hour 24 is midnight of the next day.
+
+    INDateSecondsFromCivil(1970, 1, 2, 1, 0, 0) = 90000
+    INDateSecondsFromCivil(1969, 13, 1, 0, 0, 0) = 0
+
+ @param year The year.
+ @param month The month.
+ @param day The day of the month.
+ @param hour The hour.
+ @param minute The minute.
+ @param second The second.
+ @return The seconds since the 1st January 1970, negative for times before.
+ */
+static inline int64_t INDateSecondsFromCivil(NSInteger year, NSInteger month, NSInteger day, NSInteger hour, NSInteger minute, NSInteger second) {
+    int64_t yearsInMonths = INDateFloorDivide(month - 1, 12);
+    NSInteger days = INDateDaysFromCivil(year + (NSInteger)yearsInMonths, month - (NSInteger)yearsInMonths * 12, 1) + day - 1;
+    return (int64_t)days * INDateSecondsPerDay + (int64_t)hour * 3600 + (int64_t)minute * 60 + second;
+}
+
+
+/**
+ A function which returns the offset from GMT in seconds of a time zone for a point in time.
+
+ @param context The context given to INDateTimeIntervalFromLocalTimeInterval().
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @return The time zone's offset from GMT in seconds at that time.
+ */
+typedef NSInteger (*INDateOffsetFunction)(const void *context, NSTimeInterval timeInterval);
+
+
+/**
+ Converts a local time in a time zone into the point in time.
+
+ Local times skipped by a transition, i.e. when switching to daylight saving time, are moved forward by the length of the gap
+ and local times which occur twice resolve to the first occurrence, the same as NSCalendar does.
+ The time zone's offsets are expected to not change more than once within two days.
+
+ @param localTimeInterval The local time as seconds since the 1st January 2001 00:00:00 in the time zone.
+ @param offsetFunction The function returning the time zone's offsets from GMT.
+ @param context Any context passed to the offset function.
+ @return The seconds since the reference date 1st January 2001 GMT.
+ */
+static inline NSTimeInterval INDateTimeIntervalFromLocalTimeInterval(NSTimeInterval localTimeInterval, INDateOffsetFunction offsetFunction, const void *context) {
+    NSInteger offsetBefore = offsetFunction(context, localTimeInterval - INDateSecondsPerDay);
+    NSInteger offsetAfter = offsetFunction(context, localTimeInterval + INDateSecondsPerDay);
+    NSTimeInterval timeIntervalBefore = localTimeInterval - offsetBefore;
+    if (offsetBefore == offsetAfter) {
+        return timeIntervalBefore;
+    }
+    NSTimeInterval timeIntervalAfter = localTimeInterval - offsetAfter;
+    BOOL validBefore = offsetFunction(context, timeIntervalBefore) == offsetBefore;
+    BOOL validAfter = offsetFunction(context, timeIntervalAfter) == offsetAfter;
+    if (validBefore && validAfter) {
+        // the local time occurs twice
+        return MIN(timeIntervalBefore, timeIntervalAfter);
+    }
+    if (validAfter) {
+        return timeIntervalAfter;
+    }
+    // either valid only with the offset before or skipped, then the offset before moves it behind the gap
+    return timeIntervalBefore;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
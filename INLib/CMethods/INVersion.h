@@ -0,0 +1,243 @@
+// INVersion.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ The maximum number of components an INVersion can hold.
+ */
+#define INVersionMaximumComponents 8
+
+
+/**
+ A version number like "1.2.3" parsed into its numeric components.
+
+ Versions are compared component by component, missing components count as 0, so "1.2" equals "1.2.0".
+ Parse a version once and compare it as often as needed without creating any objects.
+
+    INVersion version;
+    if (INVersionParseString(@"2.3.1", &version)) {
+        BOOL atLeast = INVersionCompare(version, INVersionMake(2, 0, 0)) != NSOrderedAscending;
+    }
+ */
+typedef struct INVersion {
+    /// the number of components which have been parsed, 0..INVersionMaximumComponents
+    NSUInteger count;
+    /// the numbers of the components, all components from count on are 0
+    uint32_t components[INVersionMaximumComponents];
+} INVersion;
+
+
+/**
+ Creates a version with three components.
+
+ @param major The first component.
+ @param minor The second component.
+ @param patch The third component.
+ @return The new version.
+ */
+static inline INVersion INVersionMake(uint32_t major, uint32_t minor, uint32_t patch) {
+    INVersion version = {3, {major, minor, patch}};
+    return version;
+}
+
+
+/**
+ Parses a version from a UTF-8 buffer.
+
+ A version consists of numbers separated by periods, an empty string is a version without components.
+ Any other character, empty components, numbers above UINT32_MAX or more than INVersionMaximumComponents components make the version invalid.
+
+ @param string The buffer with the characters, doesn't need to be null terminated.
+ @param length The number of characters in the buffer.
+ @param version On return the parsed version, not changed if the string is not valid.
+ @return True if the string is a valid version, otherwise false.
+ */
+static inline BOOL INVersionParseUTF8(const char *string, size_t length, INVersion *version) {
+    INVersion result = {0, {0}};
+    if (length == 0) {
+        *version = result;
+        return YES;
+    }
+    uint64_t component = 0;
+    BOOL hasDigits = NO;
+    for (size_t index = 0; index <= length; index++) {
+        if (index == length || string[index] == '.') {
+            if (!hasDigits || result.count == INVersionMaximumComponents) {
+                return NO;
+            }
+            result.components[result.count++] = (uint32_t)component;
+            component = 0;
+            hasDigits = NO;
+            continue;
+        }
+        char character = string[index];
+        if (character < '0' || character > '9') {
+            return NO;
+        }
+        component = component * 10 + (uint64_t)(character - '0');
+        if (component > UINT32_MAX) {
+            return NO;
+        }
+        hasDigits = YES;
+    }
+    *version = result;
+    return YES;
+}
+
+
+/**
+ Parses a version from a string.
+
+ The same as INVersionParseUTF8(), the characters are read without creating any objects.
+
+ @param string The string to parse.
+ @param version On return the parsed version, not changed if the string is not valid.
+ @return True if the string is a valid version, otherwise false and also for nil.
+ */
+static inline BOOL INVersionParseString(NSString *string, INVersion *version) {
+    if (string == nil) {
+        return NO;
+    }
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    const char *characters = CFStringGetCStringPtr(cfString, kCFStringEncodingASCII);
+    if (characters != NULL) {
+        return INVersionParseUTF8(characters, (size_t)length, version);
+    }
+
+    // longer strings or strings with non ASCII characters are no valid versions anyway
+    char buffer[INVersionMaximumComponents * 11];
+    if (length > (CFIndex)sizeof(buffer)) {
+        return NO;
+    }
+    CFIndex usedLength = 0;
+    CFIndex convertedLength = CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingASCII, 0, false, (UInt8 *)buffer, sizeof(buffer), &usedLength);
+    if (convertedLength != length) {
+        return NO;
+    }
+    return INVersionParseUTF8(buffer, (size_t)usedLength, version);
+}
+
+
+/**
+ Compares two versions component by component.
+
+ @param version The first version.
+ @param otherVersion The second version.
+ @return NSOrderedAscending if the first version is lower, NSOrderedDescending if it's higher, otherwise NSOrderedSame.
+ */
+static inline NSComparisonResult INVersionCompare(INVersion version, INVersion otherVersion) {
+    NSUInteger count = MAX(version.count, otherVersion.count);
+    for (NSUInteger index = 0; index < count; index++) {
+        if (version.components[index] != otherVersion.components[index]) {
+            return version.components[index] < otherVersion.components[index] ? NSOrderedAscending : NSOrderedDescending;
+        }
+    }
+    return NSOrderedSame;
+}
+
+
+/**
+ True if two versions are equal, missing components count as 0.
+
+ @param version The first version.
+ @param otherVersion The second version.
+ @return True if both versions are equal.
+ */
+static inline BOOL INVersionIsEqual(INVersion version, INVersion otherVersion) {
+    return INVersionCompare(version, otherVersion) == NSOrderedSame;
+}
+
+
+/**
+ Returns a hash value for a version.
+
+ Trailing zero components are ignored, so equal versions have the same hash value.
+
+ @param version The version.
+ @return The hash value.
+ */
+static inline NSUInteger INVersionHash(INVersion version) {
+    NSUInteger count = version.count;
+    while (count > 0 && version.components[count - 1] == 0) {
+        count--;
+    }
+    uint64_t hash = 14695981039346656037ULL;
+    for (NSUInteger index = 0; index < count; index++) {
+        hash = (hash ^ version.components[index]) * 1099511628211ULL;
+    }
+    return (NSUInteger)(hash ^ (hash >> 32));
+}
+
+
+/**
+ Increases a version at a specific component.
+
+ The same as NSString's versionStringIncreasedAtIndex:, each component after the index is removed and missing components before the index are filled up with 0.
+
+    INVersionIncreasedAtIndex(INVersionMake(1, 2, 3), 1); // = 1.3
+ 
+ @param version The version to increase.
+ @param index The index of the component to increase, 0..INVersionMaximumComponents - 1.
+ @return The increased version or the unchanged version if the index is out of range.
+ */
+static inline INVersion INVersionIncreasedAtIndex(INVersion version, NSUInteger index) {
+    if (index >= INVersionMaximumComponents) {
+        return version;
+    }
+    for (NSUInteger componentIndex = index + 1; componentIndex < INVersionMaximumComponents; componentIndex++) {
+        version.components[componentIndex] = 0;
+    }
+    version.components[index]++;
+    version.count = index + 1;
+    return version;
+}
+
+
+/**
+ Returns the string representation of a version with all its parsed components.
+
+ @param version The version.
+ @return A new string like "1.2.3", an empty string for versions without components.
+ */
+static inline NSString *INVersionString(INVersion version) {
+    // each component has at most 10 digits and a period
+    char buffer[INVersionMaximumComponents * 11];
+    size_t length = 0;
+    for (NSUInteger index = 0; index < version.count; index++) {
+        if (index > 0) {
+            buffer[length++] = '.';
+        }
+        length += (size_t)snprintf(buffer + length, sizeof(buffer) - length, "%u", version.components[index]);
+    }
+    return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
+
+#ifdef __cplusplus
+}
+#endif
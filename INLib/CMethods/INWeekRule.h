@@ -0,0 +1,185 @@
+// INWeekRule.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "INDateArithmetic.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ A rule for numbering the weeks of a year or a month.
+
+ The same rules as NSCalendar's firstWeekday and minimumDaysInFirstWeek, but independent of any calendar or locale.
+ The first week of a year is the first week which has at least minimumDaysInFirstWeek days in that year,
+ days before it belong to the last week of the previous year.
+
+    INWeekRule rule = INWeekRuleISO8601;
+    NSInteger weekYear;
+    NSInteger week = INWeekRuleWeekOfYearFromDays(INDateDaysFromCivil(2016, 1, 1), rule, &weekYear);
+    // week: 53, weekYear: 2015
+ */
+typedef struct INWeekRule {
+    /// the first day of the week, 1 = Sunday, 2 = Monday, ...
+    NSInteger firstWeekday;
+    /// the minimum number of days of the first week in a year or month, 1..7
+    NSInteger minimumDaysInFirstWeek;
+} INWeekRule;
+
+
+/**
+ The week rule of ISO 8601, weeks start on Monday and the first week of a year contains the first Thursday.
+ */
+static const INWeekRule INWeekRuleISO8601 = {2, 4};
+
+
+/**
+ The week rule used in the US, weeks start on Sunday and the first week of a year contains the 1st January.
+ */
+static const INWeekRule INWeekRuleUS = {1, 1};
+
+
+/**
+ Creates a week rule.
+
+ @param firstWeekday The first day of the week, 1 = Sunday, 2 = Monday, ...
+ @param minimumDaysInFirstWeek The minimum number of days of the first week in a year or month, 1..7.
+ @return The week rule.
+ */
+static inline INWeekRule INWeekRuleMake(NSInteger firstWeekday, NSInteger minimumDaysInFirstWeek) {
+    INWeekRule rule;
+    rule.firstWeekday = firstWeekday;
+    rule.minimumDaysInFirstWeek = minimumDaysInFirstWeek;
+    return rule;
+}
+
+
+/**
+ Returns the first day of the week for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @param rule The week rule.
+ @return The first day of the week as days since the 1st January 1970.
+ */
+static inline NSInteger INWeekRuleWeekStartFromDays(NSInteger days, INWeekRule rule) {
+    return INDateWeekstartFromDays(days, rule.firstWeekday);
+}
+
+
+/**
+ Returns the first day of the first week of a year or month.
+
+ @param firstDays The first day of the year or month as days since the 1st January 1970.
+ @param rule The week rule.
+ @return The first day of the first week as days since the 1st January 1970, which may be in the previous year or month.
+ */
+static inline NSInteger INWeekRuleFirstWeekStartFromDays(NSInteger firstDays, INWeekRule rule) {
+    NSInteger weekStart = INDateWeekstartFromDays(firstDays, rule.firstWeekday);
+    // the week containing the first day is the first week only if enough of its days are within the year or month
+    if (7 - (firstDays - weekStart) < rule.minimumDaysInFirstWeek) {
+        weekStart += 7;
+    }
+    return weekStart;
+}
+
+
+/**
+ Returns the week of the year for the number of days since the 1st January 1970.
+
+ Days at the beginning or the end of a year may belong to a week of the previous or next year, which will be returned as the week year.
+ The proleptic gregorian calendar is used for all days, so the results differ from NSCalendar before the 15th October 1582.
+
+ @param days The number of days since the 1st January 1970.
+ @param rule The week rule.
+ @param weekYear On return the year the week belongs to, may be NULL.
+ @return The week of the year, 1..53.
+ */
+static inline NSInteger INWeekRuleWeekOfYearFromDays(NSInteger days, INWeekRule rule, NSInteger *weekYear) {
+    NSInteger year, month, day;
+    INDateCivilFromDays(days, &year, &month, &day);
+    NSInteger firstWeekStart = INWeekRuleFirstWeekStartFromDays(INDateDaysFromCivil(year, 1, 1), rule);
+    if (days < firstWeekStart) {
+        year--;
+        firstWeekStart = INWeekRuleFirstWeekStartFromDays(INDateDaysFromCivil(year, 1, 1), rule);
+    } else if (month == 12) {
+        NSInteger nextFirstWeekStart = INWeekRuleFirstWeekStartFromDays(INDateDaysFromCivil(year + 1, 1, 1), rule);
+        if (days >= nextFirstWeekStart) {
+            year++;
+            firstWeekStart = nextFirstWeekStart;
+        }
+    }
+    if (weekYear != NULL) {
+        *weekYear = year;
+    }
+    return (days - firstWeekStart) / 7 + 1;
+}
+
+
+/**
+ Returns the week of the month for the number of days since the 1st January 1970.
+
+ Unlike the weeks of a year the weeks of a month are not moved to the previous month,
+ days before the first week of a month are in week 0 the same as with NSCalendar.
+
+ @param days The number of days since the 1st January 1970.
+ @param rule The week rule.
+ @return The week of the month, 0..6.
+ */
+static inline NSInteger INWeekRuleWeekOfMonthFromDays(NSInteger days, INWeekRule rule) {
+    NSInteger firstWeekStart = INWeekRuleFirstWeekStartFromDays(INDateFirstOfMonthFromDays(days), rule);
+    return (NSInteger)INDateFloorDivide(days - firstWeekStart, 7) + 1;
+}
+
+
+/**
+ The week of a day.
+ */
+typedef struct INWeekInformation {
+    /// the year the week belongs to, which may differ from the day's year at the beginning or end of a year
+    NSInteger weekYear;
+    /// 1..53
+    NSInteger weekOfYear;
+    /// the first day of the week as days since the 1st January 1970
+    NSInteger weekStartDays;
+} INWeekInformation;
+
+
+/**
+ Creates the week information for the number of days since the 1st January 1970.
+
+ @param days The number of days since the 1st January 1970.
+ @param rule The week rule.
+ @return The week information struct with all fields set.
+ */
+static inline INWeekInformation INWeekInformationFromDays(NSInteger days, INWeekRule rule) {
+    INWeekInformation info;
+    info.weekOfYear = INWeekRuleWeekOfYearFromDays(days, rule, &info.weekYear);
+    info.weekStartDays = INWeekRuleWeekStartFromDays(days, rule);
+    return info;
+}
+
+
+#ifdef __cplusplus
+}
+#endif
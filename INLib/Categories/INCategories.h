@@ -26,6 +26,7 @@
 #import "NSDate+INExtensions.h"
 #import "NSDateFormatter+INExtensions.h"
 #import "NSDictionary+INExtensions.h"
+#import "NSMutableArray+INExtensions.h"
 #import "NSMutableDictionary+INExtensions.h"
 #import "NSLocale+INExtensions.h"
 #import "NSObject+INExtensions.h"
@@ -21,6 +21,9 @@
 // THE SOFTWARE.
 
 
+@protocol INRandomSource;
+
+
 @interface NSArray (INExtensions)
 
 #pragma mark - Initializing with Sets
@@ -107,7 +110,7 @@
  
  The Array has to contain objects which are Key-Value-Compliant for the given key.
  The objects will be sorted by the given key either in ascending or in descending order.
- The sort will be done by NSArray's sortedArrayUsingDescriptors with a NSSortDescriptor.
+ The sort will be done by arraySortedWithDescriptors: with a NSSortDescriptor, so each object's key is read only once and objects with equal keys keep their order.
  
  @param key The property's name of the objects in the array for which to sort the array.
  @param ascending YES if the new array should be sorted ascending or NO if it should be sorted descending.
@@ -116,13 +119,63 @@
 - (NSArray *)arraySortedByKey:(NSString *)key ascending:(BOOL)ascending;
 
 
+/**
+ Sorts an array by several property names, the later keys decide when the earlier ones are equal.
+ 
+ @param keys The properties' names of the objects in the array for which to sort the array.
+ @param ascending YES if the new array should be sorted ascending or NO if it should be sorted descending by all keys.
+ @return A new sorted array with the same objects sorted by the keys.
+ @see arraySortedWithDescriptors:
+ */
+- (NSArray *)arraySortedByKeys:(NSArray *)keys ascending:(BOOL)ascending;
+
+
+/**
+ Sorts an array like sortedArrayUsingDescriptors:, but reads each object's keys only once and keeps the order of equal objects.
+ 
+ NSArray's sortedArrayUsingDescriptors: reads the keys of both objects for each comparison, which are O(n log n) key-value-coding lookups.
+ This method reads all keys into buffers first and sorts the indexes of the objects.
+ When a descriptor uses compare: and all keys are NSNumbers or all are NSDates, they are compared as numbers without sending any messages.
+ A single key of numbers or dates is sorted with a radix sort in O(n), other keys with a merge sort, which runs on all processors for very large arrays.
+ Comparators and selectors of the descriptors have to be safe to call from several threads at the same time.
+ 
+ @param sortDescriptors The NSSortDescriptors to sort by, a descriptor without key compares the objects themselves.
+ @return A new sorted array with the same objects.
+ */
+- (NSArray *)arraySortedWithDescriptors:(NSArray *)sortDescriptors;
+
+
+/**
+ Sorts an array of version strings by their versions.
+ 
+ Each string is parsed only once into an INVersion, equal versions keep their order.
+ Objects which are no valid versions, see INVersionParseString(), are treated as lower than all versions and keep their order, too.
+ 
+    [@[@"1.10", @"1.2", @"1.2.0.1"] arraySortedByVersionAscending:YES]; // returns @[@"1.2", @"1.2.0.1", @"1.10"]
+ 
+ @param ascending YES if the new array should be sorted ascending or NO if it should be sorted descending.
+ @return A new sorted array with the same strings.
+ */
+- (NSArray *)arraySortedByVersionAscending:(BOOL)ascending;
+
+
+/**
+ Returns the string with the highest version of an array of version strings.
+ 
+ Each string is parsed only once into an INVersion, objects which are no valid versions are ignored.
+ 
+ @return The first string with the highest version or nil if the array has no valid version.
+ */
+- (NSString *)maximumVersion;
+
+
 #pragma mark - Array randomizing
 /// @name Array randomizing
 
 /**
  Returns a new array with randomly chosen elements removed from this array. The order of the elements remains unchanged.
  
- Uses INRandom for generating random values.
+ Uses arc4random() for generating random values, the kept elements are chosen like in arrayWithRandomElementsChosen:preservingOrder:usingRandomSource:.
  
  @param numberOfElements How many elements should be removed. If the number is equal or higher than the array has elements in it an empty array will be returned.
  @return A new array with a subset of this one.
@@ -130,10 +183,21 @@
 - (NSArray *)arrayWithRandomElementsRemoved:(NSUInteger)numberOfElements;
 
 
+/**
+ Returns a new array with randomly chosen elements removed from this array using random numbers from a source.
+ 
+ @param numberOfElements How many elements should be removed. If the number is equal or higher than the array has elements in it an empty array will be returned.
+ @param preserveOrder True to keep the order of the remaining elements, false to return them in random order.
+ @param source The source of the random numbers or nil for arc4random().
+ @return A new array with a subset of this one.
+ */
+- (NSArray *)arrayWithRandomElementsRemoved:(NSUInteger)numberOfElements preservingOrder:(BOOL)preserveOrder usingRandomSource:(id<INRandomSource>)source;
+
+
 /**
  Returns a new array with randomly chosen elements added from this array. The order of the elements remains unchanged.
  
- Uses INRandom for generating random values.
+ Uses arc4random() for generating random values, the elements are chosen like in arrayWithRandomElementsChosen:preservingOrder:usingRandomSource:.
 
  @param numberOfElements How many elements should be chosen. If the number is equal or higher than the array has elements in it a copy of the array will be returned.
  @return A new array with a subset of the given one.
@@ -141,16 +205,57 @@
 - (NSArray *)arrayWithRandomElementsChosen:(NSUInteger)numberOfElements;
 
 
+/**
+ Returns a new array with randomly chosen elements from this array using random numbers from a source.
+ 
+ Without copying the array the indexes are drawn with Floyd's algorithm in O(k log k) for k elements, which is much faster than O(n) when only a few elements are chosen from a large array.
+ When more than a quarter of the elements are chosen the array is scanned once with selection sampling instead.
+ Each subset of the elements is equally likely.
+ 
+ @param numberOfElements How many elements should be chosen. If the number is equal or higher than the array has elements in it all elements will be returned.
+ @param preserveOrder True to return the elements in the same order as in this array, false to return them in random order.
+ @param source The source of the random numbers or nil for arc4random().
+ @return A new array with a subset of the given one.
+ */
+- (NSArray *)arrayWithRandomElementsChosen:(NSUInteger)numberOfElements preservingOrder:(BOOL)preserveOrder usingRandomSource:(id<INRandomSource>)source;
+
+
+/**
+ Returns randomly chosen elements from any enumeration in one pass without collecting all elements.
+ 
+ The elements are drawn with reservoir sampling, so only the chosen elements are kept while enumerating and each subset of the enumerated elements is equally likely.
+ Use this for large or generated sequences like an NSEnumerator reading lines from a file.
+ 
+ @param numberOfElements How many elements should be chosen. If the enumeration has fewer elements all of them will be returned.
+ @param enumeration The enumeration to choose from, i.e. an NSEnumerator, NSSet or NSArray.
+ @param preserveOrder True to return the elements in the order of the enumeration, false to return them in random order.
+ @param source The source of the random numbers or nil for arc4random().
+ @return A new array with the chosen elements.
+ */
++ (NSArray *)arrayWithRandomElementsChosen:(NSUInteger)numberOfElements fromEnumeration:(id<NSFastEnumeration>)enumeration preservingOrder:(BOOL)preserveOrder usingRandomSource:(id<INRandomSource>)source;
+
+
 /**
  Returns a new array with the elements in random order.
  
- Uses INRandom for generating random values.
+ Uses the Fisher-Yates algorithm in O(n) with arc4random() for generating random values, the elements are copied only once.
 
  @return A new array with the same objects, but in random order.
  */
 - (NSArray *)arrayWithRandomizedOrder;
 
 
+/**
+ Returns a new array with the elements in random order using random numbers from a source.
+ 
+ Uses the Fisher-Yates algorithm in O(n), a seeded source like INSeededRandom always returns the same order.
+ 
+ @param source The source of the random numbers or nil for arc4random().
+ @return A new array with the same objects, but in random order.
+ */
+- (NSArray *)arrayWithRandomizedOrderUsingRandomSource:(id<INRandomSource>)source;
+
+
 /**
  Returns a random object from this array.
  
@@ -161,4 +266,74 @@
 - (id)randomObject;
 
 
+#pragma mark - Concurrent processing
+/// @name Concurrent processing
+
+/**
+ Enumerates the array in chunks of consecutive elements on several threads.
+ 
+ The array is split into more chunks than threads, each thread takes the next unprocessed chunk when done, so slow chunks don't hold up the others.
+ Arrays with less than 1024 elements are enumerated as one chunk on the calling thread, the thread dispatching and synchronizing would cost more than it saves.
+ The method returns after all chunks have been processed. The block has to be safe to call from several threads at the same time.
+ 
+ @param maximumThreads The maximum number of threads working at the same time or 0 for the number of active processors.
+ @param block The block called for each chunk with the range of the chunk's elements, set stop to true to skip all chunks not yet started.
+ */
+- (void)enumerateChunksConcurrentlyWithMaximumThreads:(NSUInteger)maximumThreads usingBlock:(void (^)(NSRange range, BOOL *stop))block;
+
+
+/**
+ Returns a new array with the results of a block for each element, calculated concurrently on all processors.
+ 
+ See enumerateChunksConcurrentlyWithMaximumThreads:usingBlock: for the way the work is split. The results are in the same order as the elements.
+ 
+ @param block The block returning a new object for an element, a nil result is replaced by NSNull.
+ @return A new array with the same number of objects.
+ */
+- (NSArray *)concurrentlyMappedArrayUsingBlock:(id (^)(id obj))block;
+
+
+/**
+ Returns a new array with all elements passing a test, which is run concurrently on all processors.
+ 
+ Each chunk collects the indexes of its passing elements, the array is assembled afterwards so the order of the elements remains unchanged.
+ 
+ @param predicate The test which has to return YES for the elements to keep.
+ @return A new array with the passing elements.
+ */
+- (NSArray *)concurrentlyFilteredArrayUsingBlock:(BOOL (^)(id obj))predicate;
+
+
+/**
+ Combines all elements into one value, calculated concurrently on all processors.
+ 
+ Each chunk reduces its elements starting with the initial value, afterwards the chunks' results are combined in order.
+ So the initial value has to be neutral for the combination, i.e. 0 for sums, and the combination has to be associative.
+ 
+    NSNumber *sum = [numbers concurrentlyReducedObjectWithInitialValue:@0 reduceBlock:^id(NSNumber *result, NSNumber *obj) {
+        return @(result.integerValue + obj.integerValue);
+    } combineBlock:^id(NSNumber *result, NSNumber *otherResult) {
+        return @(result.integerValue + otherResult.integerValue);
+    }];
+ 
+ @param initialValue The value the reduction of each chunk starts with and which is returned for an empty array.
+ @param reduceBlock The block returning the result of adding an element to a previous result.
+ @param combineBlock The block returning the combination of two results, the first one for the elements before the second one's elements.
+ @return The result of the reduction.
+ */
+- (id)concurrentlyReducedObjectWithInitialValue:(id)initialValue reduceBlock:(id (^)(id result, id obj))reduceBlock combineBlock:(id (^)(id result, id otherResult))combineBlock;
+
+
+/**
+ Checks whether any element passes a test, which is run concurrently on all processors.
+ 
+ All threads stop testing as soon as one element passes, so the order in which the elements are tested is undefined.
+ 
+ @param predicate The test which has to return YES for the element to find.
+ @return True if at least one element passes the test.
+ @see firstObjectPassingTest:
+ */
+- (BOOL)anyObjectPassingTest:(BOOL (^)(id obj))predicate;
+
+
 @end
@@ -23,6 +23,308 @@
 
 #import "NSArray+INExtensions.h"
 #import "INRandom.h"
+#import "INVersion.h"
+#import "INConcurrentChunks.h"
+#import <stdatomic.h>
+#import <objc/message.h>
+
+
+// A parsed version together with the index of its string in the array.
+typedef struct INVersionSortEntry {
+    INVersion version;
+    NSUInteger index;
+    BOOL valid;
+} INVersionSortEntry;
+
+// Adds an index to a hash set with open addressing of a power of 2 capacity, the indexes are stored increased by 1 so 0 is empty.
+// Returns false if the index is already in the set.
+static inline BOOL INArrayIndexSetAdd(NSUInteger *slots, NSUInteger mask, NSUInteger index) {
+    NSUInteger slot = (index * (NSUInteger)0x9E3779B97F4A7C15ULL) & mask;
+    while (slots[slot] != 0) {
+        if (slots[slot] == index + 1) {
+            return NO;
+        }
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = index + 1;
+    return YES;
+}
+
+// Writes count distinct random indexes below the upper bound into the buffer in ascending order.
+static void INArrayChooseRandomIndexes(NSUInteger *indexes, NSUInteger count, NSUInteger upperBound, id<INRandomSource> source) {
+    if (count > upperBound / 4) {
+        // selection sampling visits each index once, choosing it with the probability of the still needed indexes
+        NSUInteger chosen = 0;
+        for (NSUInteger index = 0; index < upperBound && chosen < count; index++) {
+            if ([INRandom integerBelow:upperBound - index withRandomSource:source] < count - chosen) {
+                indexes[chosen++] = index;
+            }
+        }
+        return;
+    }
+
+    // Floyd's algorithm draws exactly count numbers, taking the upper index whenever the drawn one has been chosen before
+    NSUInteger capacity = 4;
+    while (capacity < 2 * count) {
+        capacity *= 2;
+    }
+    NSUInteger *slots = calloc(capacity, sizeof(NSUInteger));
+    NSUInteger chosen = 0;
+    for (NSUInteger upperIndex = upperBound - count; upperIndex < upperBound; upperIndex++) {
+        NSUInteger index = [INRandom integerBelow:upperIndex + 1 withRandomSource:source];
+        if (!INArrayIndexSetAdd(slots, capacity - 1, index)) {
+            index = upperIndex;
+            INArrayIndexSetAdd(slots, capacity - 1, index);
+        }
+        indexes[chosen++] = index;
+    }
+    free(slots);
+    qsort_b(indexes, count, sizeof(NSUInteger), ^int(const void *first, const void *second) {
+        NSUInteger firstIndex = *(const NSUInteger *)first;
+        NSUInteger secondIndex = *(const NSUInteger *)second;
+        return firstIndex < secondIndex ? -1 : (firstIndex > secondIndex ? 1 : 0);
+    });
+}
+
+// arrays with fewer elements are processed on the calling thread
+static const NSUInteger INArrayConcurrentThreshold = 1024;
+
+// arrays with at least this number of objects are merge sorted on several threads
+static const NSUInteger INArraySortConcurrentThreshold = 65536;
+
+// ranges up to this length are sorted by insertion instead of merging
+static const NSUInteger INArraySortInsertionLength = 16;
+
+// The extracted keys of all objects for one sort descriptor.
+typedef struct INArraySortKey {
+    // the numbers or dates encoded as integers in the sort order, NULL if the keys are compared as objects
+    uint64_t *numbers;
+    // the keys compared with the selector or comparator, retained by an array in the sorting method
+    __unsafe_unretained id *objects;
+    SEL selector;
+    __unsafe_unretained NSComparator comparator;
+    BOOL ascending;
+} INArraySortKey;
+
+// A key encoded as integer together with the index of its object.
+typedef struct INArrayRadixEntry {
+    uint64_t key;
+    NSUInteger index;
+} INArrayRadixEntry;
+
+// Returns the key for an object which has no value for the key path, so it can be kept in an array.
+static NSObject *INArraySortNilKey(void) {
+    static NSObject *nilKey = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        nilKey = [[NSObject alloc] init];
+    });
+    return nilKey;
+}
+
+// Encodes the keys as integers with the same order as compare:, if they are all numbers or all dates.
+// NaN, decimal numbers and integers which don't fit into a double together with floating point numbers aren't encoded.
+static uint64_t *INArraySortKeyEncodeNumbers(__unsafe_unretained id *objects, NSUInteger count, BOOL ascending) {
+    BOOL hasNumbers = NO;
+    BOOL hasDates = NO;
+    BOOL hasFloats = NO;
+    BOOL hasLargeIntegers = NO;
+    for (NSUInteger index = 0; index < count; index++) {
+        id object = objects[index];
+        if ([object isKindOfClass:[NSNumber class]] && ![object isKindOfClass:[NSDecimalNumber class]]) {
+            hasNumbers = YES;
+            // booleans are CFBoolean and no CFNumber, so they are checked by their type before calling any CFNumber function
+            char type = *[object objCType];
+            if (type == 'c' || type == 'B') {
+                continue;
+            } else if (CFNumberIsFloatType((__bridge CFNumberRef)object)) {
+                if (isnan([object doubleValue])) {
+                    return NULL;
+                }
+                hasFloats = YES;
+            } else if (type == 'Q' && [object unsignedLongLongValue] > INT64_MAX) {
+                return NULL;
+            } else {
+                long long value = [object longLongValue];
+                hasLargeIntegers |= value > (1LL << 53) || value < -(1LL << 53);
+            }
+        } else if ([object isKindOfClass:[NSDate class]]) {
+            hasDates = YES;
+        } else {
+            return NULL;
+        }
+    }
+    if ((hasNumbers && hasDates) || (hasFloats && hasLargeIntegers)) {
+        return NULL;
+    }
+
+    uint64_t *numbers = malloc(count * sizeof(uint64_t));
+    for (NSUInteger index = 0; index < count; index++) {
+        id object = objects[index];
+        uint64_t number;
+        if (hasDates || hasFloats) {
+            // positive doubles are ordered like their bits with the sign set, negative ones like their inverted bits
+            double value = hasDates ? [object timeIntervalSinceReferenceDate] : [object doubleValue];
+            if (value == 0) {
+                value = 0;
+            }
+            memcpy(&number, &value, sizeof(number));
+            number = (number & 0x8000000000000000ULL) ? ~number : number | 0x8000000000000000ULL;
+        } else {
+            number = (uint64_t)[object longLongValue] ^ 0x8000000000000000ULL;
+        }
+        numbers[index] = ascending ? number : ~number;
+    }
+    return numbers;
+}
+
+// Compares the keys of two objects.
+static inline NSComparisonResult INArraySortKeyCompare(const INArraySortKey *sortKey, NSUInteger first, NSUInteger second) {
+    if (sortKey->numbers != NULL) {
+        uint64_t firstNumber = sortKey->numbers[first];
+        uint64_t secondNumber = sortKey->numbers[second];
+        return firstNumber < secondNumber ? NSOrderedAscending : (firstNumber > secondNumber ? NSOrderedDescending : NSOrderedSame);
+    }
+    id firstObject = sortKey->objects[first];
+    id secondObject = sortKey->objects[second];
+    NSObject *nilKey = INArraySortNilKey();
+    firstObject = firstObject != nilKey ? firstObject : nil;
+    secondObject = secondObject != nilKey ? secondObject : nil;
+    NSComparisonResult result;
+    if (sortKey->comparator != nil) {
+        result = sortKey->comparator(firstObject, secondObject);
+    } else {
+        result = ((NSComparisonResult (*)(id, SEL, id))objc_msgSend)(firstObject, sortKey->selector, secondObject);
+    }
+    return sortKey->ascending ? result : -result;
+}
+
+// Compares two objects by all keys.
+static inline NSComparisonResult INArraySortKeysCompare(const INArraySortKey *sortKeys, NSUInteger keyCount, NSUInteger first, NSUInteger second) {
+    for (NSUInteger key = 0; key < keyCount; key++) {
+        NSComparisonResult result = INArraySortKeyCompare(&sortKeys[key], first, second);
+        if (result != NSOrderedSame) {
+            return result;
+        }
+    }
+    return NSOrderedSame;
+}
+
+// Sorts the indexes by their encoded keys with a stable radix sort of 8 bits per pass, the passes over equal bytes are skipped.
+static void INArrayRadixSort(const uint64_t *numbers, NSUInteger *indexes, NSUInteger count) {
+    INArrayRadixEntry *entries = malloc(count * sizeof(INArrayRadixEntry));
+    INArrayRadixEntry *buffer = malloc(count * sizeof(INArrayRadixEntry));
+    NSUInteger (*histograms)[256] = calloc(8, sizeof(*histograms));
+    for (NSUInteger index = 0; index < count; index++) {
+        entries[index].key = numbers[index];
+        entries[index].index = index;
+        for (NSUInteger byte = 0; byte < 8; byte++) {
+            histograms[byte][(numbers[index] >> (8 * byte)) & 0xFF]++;
+        }
+    }
+
+    for (NSUInteger byte = 0; byte < 8; byte++) {
+        NSUInteger *histogram = histograms[byte];
+        if (histogram[(entries[0].key >> (8 * byte)) & 0xFF] == count) {
+            continue;
+        }
+        NSUInteger offset = 0;
+        for (NSUInteger value = 0; value < 256; value++) {
+            NSUInteger valueCount = histogram[value];
+            histogram[value] = offset;
+            offset += valueCount;
+        }
+        for (NSUInteger index = 0; index < count; index++) {
+            buffer[histogram[(entries[index].key >> (8 * byte)) & 0xFF]++] = entries[index];
+        }
+        INArrayRadixEntry *sorted = buffer;
+        buffer = entries;
+        entries = sorted;
+    }
+
+    for (NSUInteger index = 0; index < count; index++) {
+        indexes[index] = entries[index].index;
+    }
+    free(histograms);
+    free(buffer);
+    free(entries);
+}
+
+// Merges the sorted ranges [start, middle) and [middle, end) of the indexes, taking the left index on equal keys.
+static void INArrayMerge(NSUInteger *indexes, NSUInteger *buffer, NSUInteger start, NSUInteger middle, NSUInteger end, const INArraySortKey *sortKeys, NSUInteger keyCount) {
+    if (INArraySortKeysCompare(sortKeys, keyCount, indexes[middle - 1], indexes[middle]) != NSOrderedDescending) {
+        return;
+    }
+    memcpy(buffer + start, indexes + start, (end - start) * sizeof(NSUInteger));
+    NSUInteger left = start;
+    NSUInteger right = middle;
+    NSUInteger target = start;
+    while (left < middle && right < end) {
+        if (INArraySortKeysCompare(sortKeys, keyCount, buffer[right], buffer[left]) == NSOrderedAscending) {
+            indexes[target++] = buffer[right++];
+        } else {
+            indexes[target++] = buffer[left++];
+        }
+    }
+    while (left < middle) {
+        indexes[target++] = buffer[left++];
+    }
+    while (right < end) {
+        indexes[target++] = buffer[right++];
+    }
+}
+
+// Sorts the range [start, end) of the indexes with a stable merge sort, the buffer has to have the same size as the indexes.
+static void INArrayMergeSort(NSUInteger *indexes, NSUInteger *buffer, NSUInteger start, NSUInteger end, const INArraySortKey *sortKeys, NSUInteger keyCount) {
+    if (end - start <= INArraySortInsertionLength) {
+        for (NSUInteger position = start + 1; position < end; position++) {
+            NSUInteger index = indexes[position];
+            NSUInteger target = position;
+            while (target > start && INArraySortKeysCompare(sortKeys, keyCount, index, indexes[target - 1]) == NSOrderedAscending) {
+                indexes[target] = indexes[target - 1];
+                target--;
+            }
+            indexes[target] = index;
+        }
+        return;
+    }
+    NSUInteger middle = start + (end - start) / 2;
+    INArrayMergeSort(indexes, buffer, start, middle, sortKeys, keyCount);
+    INArrayMergeSort(indexes, buffer, middle, end, sortKeys, keyCount);
+    INArrayMerge(indexes, buffer, start, middle, end, sortKeys, keyCount);
+}
+
+// Merge sorts the indexes, large arrays are split into runs which are sorted and merged pairwise on several threads.
+static void INArrayConcurrentMergeSort(NSUInteger *indexes, NSUInteger count, const INArraySortKey *sortKeys, NSUInteger keyCount) {
+    NSUInteger *buffer = malloc(count * sizeof(NSUInteger));
+    NSUInteger processorCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    if (count < INArraySortConcurrentThreshold || processorCount < 2) {
+        INArrayMergeSort(indexes, buffer, 0, count, sortKeys, keyCount);
+        free(buffer);
+        return;
+    }
+
+    // a power of 2 of runs, so they can be merged in pairs until one is left
+    NSUInteger runCount = 1;
+    while (runCount < 2 * processorCount) {
+        runCount *= 2;
+    }
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_apply(runCount, queue, ^(size_t run) {
+        @autoreleasepool {
+            INArrayMergeSort(indexes, buffer, count * run / runCount, count * (run + 1) / runCount, sortKeys, keyCount);
+        }
+    });
+    for (NSUInteger width = 1; width < runCount; width *= 2) {
+        dispatch_apply(runCount / (2 * width), queue, ^(size_t pair) {
+            @autoreleasepool {
+                NSUInteger run = pair * 2 * width;
+                INArrayMerge(indexes, buffer, count * run / runCount, count * (run + width) / runCount, count * (run + 2 * width) / runCount, sortKeys, keyCount);
+            }
+        });
+    }
+    free(buffer);
+}
 
 
 @implementation NSArray (INExtensions)
@@ -65,10 +367,130 @@
 - (NSArray *)arraySortedByKey:(NSString *)key ascending:(BOOL)ascending {
 	NSSortDescriptor *sortDescriptor = [[NSSortDescriptor alloc] initWithKey:key ascending:ascending];
 	NSArray *descriptors = [[NSArray alloc] initWithObjects:sortDescriptor, nil];
-	NSArray *sortedArray = [self sortedArrayUsingDescriptors:descriptors];
+	NSArray *sortedArray = [self arraySortedWithDescriptors:descriptors];
 	return sortedArray;
 }
 
+- (NSArray *)arraySortedByKeys:(NSArray *)keys ascending:(BOOL)ascending {
+    NSMutableArray *descriptors = [NSMutableArray arrayWithCapacity:keys.count];
+    for (NSString *key in keys) {
+        [descriptors addObject:[[NSSortDescriptor alloc] initWithKey:key ascending:ascending]];
+    }
+    return [self arraySortedWithDescriptors:descriptors];
+}
+
+- (NSArray *)arraySortedWithDescriptors:(NSArray *)sortDescriptors {
+    NSUInteger count = self.count;
+    NSUInteger keyCount = sortDescriptors.count;
+    if (count < 2 || keyCount == 0) {
+        return [NSArray arrayWithArray:self];
+    }
+
+    // decorate: read all keys once, the arrays retain them while sorting
+    NSMutableArray *keyArrays = [NSMutableArray arrayWithCapacity:keyCount];
+    for (NSSortDescriptor *descriptor in sortDescriptors) {
+        NSMutableArray *keyArray = [NSMutableArray arrayWithCapacity:count];
+        NSString *keyPath = descriptor.key;
+        for (NSUInteger start = 0; start < count; start += 256) {
+            @autoreleasepool {
+                for (NSUInteger index = start; index < MIN(start + 256, count); index++) {
+                    id value = keyPath != nil ? [self[index] valueForKeyPath:keyPath] : self[index];
+                    [keyArray addObject:value != nil ? value : INArraySortNilKey()];
+                }
+            }
+        }
+        [keyArrays addObject:keyArray];
+    }
+    INArraySortKey *sortKeys = calloc(keyCount, sizeof(INArraySortKey));
+    for (NSUInteger key = 0; key < keyCount; key++) {
+        NSSortDescriptor *descriptor = sortDescriptors[key];
+        INArraySortKey *sortKey = &sortKeys[key];
+        sortKey->objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+        [keyArrays[key] getObjects:sortKey->objects range:NSMakeRange(0, count)];
+        sortKey->selector = descriptor.selector;
+        sortKey->comparator = descriptor.comparator;
+        sortKey->ascending = descriptor.ascending;
+        if (sortKey->comparator == nil && sortKey->selector == @selector(compare:)) {
+            sortKey->numbers = INArraySortKeyEncodeNumbers(sortKey->objects, count, sortKey->ascending);
+        }
+    }
+
+    // sort the indexes
+    NSUInteger *indexes = malloc(count * sizeof(NSUInteger));
+    if (keyCount == 1 && sortKeys[0].numbers != NULL) {
+        INArrayRadixSort(sortKeys[0].numbers, indexes, count);
+    } else {
+        for (NSUInteger index = 0; index < count; index++) {
+            indexes[index] = index;
+        }
+        INArrayConcurrentMergeSort(indexes, count, sortKeys, keyCount);
+    }
+
+    // undecorate
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    for (NSUInteger index = 0; index < count; index++) {
+        objects[index] = self[indexes[index]];
+    }
+    NSArray *array = [NSArray arrayWithObjects:objects count:count];
+    free(objects);
+    free(indexes);
+    for (NSUInteger key = 0; key < keyCount; key++) {
+        free(sortKeys[key].numbers);
+        free(sortKeys[key].objects);
+    }
+    free(sortKeys);
+    return array;
+}
+
+- (NSArray *)arraySortedByVersionAscending:(BOOL)ascending {
+    NSUInteger count = self.count;
+    INVersionSortEntry *entries = malloc(MAX(count, (NSUInteger)1) * sizeof(INVersionSortEntry));
+    for (NSUInteger index = 0; index < count; index++) {
+        id string = self[index];
+        entries[index].index = index;
+        entries[index].valid = [string isKindOfClass:[NSString class]] && INVersionParseString(string, &entries[index].version);
+    }
+
+    // invalid versions are the lowest ones, equal versions are ordered by their index to keep the sort stable
+    qsort_b(entries, count, sizeof(INVersionSortEntry), ^int(const void *first, const void *second) {
+        const INVersionSortEntry *entry = first;
+        const INVersionSortEntry *otherEntry = second;
+        NSComparisonResult result = NSOrderedSame;
+        if (entry->valid != otherEntry->valid) {
+            result = entry->valid ? NSOrderedDescending : NSOrderedAscending;
+        } else if (entry->valid) {
+            result = INVersionCompare(entry->version, otherEntry->version);
+        }
+        if (result == NSOrderedSame) {
+            return entry->index < otherEntry->index ? -1 : 1;
+        }
+        return (int)(ascending ? result : -result);
+    });
+
+    NSMutableArray *sortedArray = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [sortedArray addObject:self[entries[index].index]];
+    }
+    free(entries);
+    return sortedArray;
+}
+
+- (NSString *)maximumVersion {
+    NSString *maximumString = nil;
+    INVersion maximumVersion;
+    for (id string in self) {
+        INVersion version;
+        if (![string isKindOfClass:[NSString class]] || !INVersionParseString(string, &version)) {
+            continue;
+        }
+        if (maximumString == nil || INVersionCompare(version, maximumVersion) == NSOrderedDescending) {
+            maximumString = string;
+            maximumVersion = version;
+        }
+    }
+    return maximumString;
+}
+
 - (id)firstObjectPassingTest:(BOOL (^)(id obj))predicate {
     id obj = nil;
     NSUInteger index = [self indexOfObjectPassingTest:^(id obj, NSUInteger idx, BOOL *stop) {
@@ -83,45 +505,111 @@
 }
 
 - (NSArray *)arrayWithRandomElementsRemoved:(NSUInteger)numberOfElements {
+    return [self arrayWithRandomElementsRemoved:numberOfElements preservingOrder:YES usingRandomSource:nil];
+}
+
+- (NSArray *)arrayWithRandomElementsRemoved:(NSUInteger)numberOfElements preservingOrder:(BOOL)preserveOrder usingRandomSource:(id<INRandomSource>)source {
     if (numberOfElements >= self.count) {
         return [NSArray array];
     }
-    if (numberOfElements == 0) {
-        return [NSArray arrayWithArray:self];
-    }
-    
-    NSMutableArray *mutableArray = [[NSMutableArray alloc] initWithArray:self];
-    for (NSUInteger i = 0; i < numberOfElements; i++) {
-        [mutableArray removeObjectAtIndex:[INRandom integerWithin:0 and:mutableArray.count - 1]];
-    }
-    return mutableArray;
+    // removing elements is the same as choosing the remaining ones
+    return [self arrayWithRandomElementsChosen:self.count - numberOfElements preservingOrder:preserveOrder usingRandomSource:source];
 }
 
 - (NSArray *)arrayWithRandomElementsChosen:(NSUInteger)numberOfElements {
+    return [self arrayWithRandomElementsChosen:numberOfElements preservingOrder:YES usingRandomSource:nil];
+}
+
+- (NSArray *)arrayWithRandomElementsChosen:(NSUInteger)numberOfElements preservingOrder:(BOOL)preserveOrder usingRandomSource:(id<INRandomSource>)source {
     if (numberOfElements >= self.count) {
-        return [NSArray arrayWithArray:self];
+        return preserveOrder ? [NSArray arrayWithArray:self] : [self arrayWithRandomizedOrderUsingRandomSource:source];
     }
     if (numberOfElements == 0) {
         return [NSArray array];
     }
-    
-    NSMutableArray *mutableArray = [[NSMutableArray alloc] initWithArray:self];
-    for (NSUInteger i = 0; i < self.count - numberOfElements; i++) {
-        [mutableArray removeObjectAtIndex:[INRandom integerWithin:0 and:mutableArray.count - 1]];
+
+    NSUInteger *indexes = malloc(numberOfElements * sizeof(NSUInteger));
+    INArrayChooseRandomIndexes(indexes, numberOfElements, self.count, source);
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(numberOfElements * sizeof(id));
+    for (NSUInteger index = 0; index < numberOfElements; index++) {
+        objects[index] = self[indexes[index]];
     }
-    return mutableArray;
+    if (!preserveOrder) {
+        [INRandom shuffleObjects:objects count:numberOfElements withRandomSource:source];
+    }
+    NSArray *array = [NSArray arrayWithObjects:objects count:numberOfElements];
+    free(objects);
+    free(indexes);
+    return array;
+}
+
++ (NSArray *)arrayWithRandomElementsChosen:(NSUInteger)numberOfElements fromEnumeration:(id<NSFastEnumeration>)enumeration preservingOrder:(BOOL)preserveOrder usingRandomSource:(id<INRandomSource>)source {
+    if (numberOfElements == 0) {
+        return [NSArray array];
+    }
+
+    // the reservoir keeps the chosen elements together with their positions in the enumeration
+    NSMutableArray *reservoir = [NSMutableArray array];
+    NSMutableData *positionData = [NSMutableData data];
+    NSUInteger position = 0;
+    for (id object in enumeration) {
+        if (position < numberOfElements) {
+            [reservoir addObject:object];
+            [positionData appendBytes:&position length:sizeof(position)];
+        } else {
+            // the nth element replaces a chosen one with the probability k/n
+            NSUInteger slot = [INRandom integerBelow:position + 1 withRandomSource:source];
+            if (slot < numberOfElements) {
+                reservoir[slot] = object;
+                ((NSUInteger *)positionData.mutableBytes)[slot] = position;
+            }
+        }
+        position++;
+    }
+
+    NSUInteger count = reservoir.count;
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(MAX(count, 1) * sizeof(id));
+    [reservoir getObjects:objects range:NSMakeRange(0, count)];
+    if (preserveOrder) {
+        const NSUInteger *positions = positionData.bytes;
+        NSUInteger *slots = malloc(MAX(count, 1) * sizeof(NSUInteger));
+        for (NSUInteger slot = 0; slot < count; slot++) {
+            slots[slot] = slot;
+        }
+        qsort_b(slots, count, sizeof(NSUInteger), ^int(const void *first, const void *second) {
+            NSUInteger firstPosition = positions[*(const NSUInteger *)first];
+            NSUInteger secondPosition = positions[*(const NSUInteger *)second];
+            return firstPosition < secondPosition ? -1 : (firstPosition > secondPosition ? 1 : 0);
+        });
+        for (NSUInteger index = 0; index < count; index++) {
+            objects[index] = reservoir[slots[index]];
+        }
+        free(slots);
+    } else {
+        // the first elements stay in their slots when not replaced, so the reservoir's order isn't random
+        [INRandom shuffleObjects:objects count:count withRandomSource:source];
+    }
+    NSArray *array = [NSArray arrayWithObjects:objects count:count];
+    free(objects);
+    return array;
 }
 
 - (NSArray *)arrayWithRandomizedOrder {
-    NSMutableArray *mutableArray = [[NSMutableArray alloc] initWithArray:self];
-    NSMutableArray *resultArray = [[NSMutableArray alloc] initWithCapacity:self.count];
-    for (NSUInteger i = 0; i < self.count; i++) {
-        NSUInteger randomIndex = [INRandom integerWithin:0 and:mutableArray.count - 1];
-        id element = [mutableArray objectAtIndex:randomIndex];
-        [resultArray addObject:element];
-        [mutableArray removeObjectAtIndex:randomIndex];
+    return [self arrayWithRandomizedOrderUsingRandomSource:nil];
+}
+
+- (NSArray *)arrayWithRandomizedOrderUsingRandomSource:(id<INRandomSource>)source {
+    NSUInteger count = self.count;
+    if (count == 0) {
+        return [NSArray array];
     }
-    return resultArray;
+
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    [self getObjects:objects range:NSMakeRange(0, count)];
+    [INRandom shuffleObjects:objects count:count withRandomSource:source];
+    NSArray *array = [NSArray arrayWithObjects:objects count:count];
+    free(objects);
+    return array;
 }
 
 - (id)randomObject {
@@ -134,4 +622,122 @@
 }
 
 
+#pragma mark - Concurrent processing
+
+- (void)enumerateChunksConcurrentlyWithMaximumThreads:(NSUInteger)maximumThreads usingBlock:(void (^)(NSRange range, BOOL *stop))block {
+    INChunks chunks = INChunksMake(self.count, INArrayConcurrentThreshold, maximumThreads);
+    INChunksEnumerate(chunks, ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        block(range, stop);
+    });
+}
+
+- (NSArray *)concurrentlyMappedArrayUsingBlock:(id (^)(id obj))block {
+    NSUInteger count = self.count;
+    if (count == 0) {
+        return [NSArray array];
+    }
+
+    // the results are retained in the buffer, so they survive the chunks' autorelease pools
+    CFTypeRef *results = malloc(count * sizeof(CFTypeRef));
+    INChunks chunks = INChunksMake(count, INArrayConcurrentThreshold, 0);
+    INChunksEnumerate(chunks, ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            id result = block(self[index]);
+            results[index] = CFBridgingRetain(result != nil ? result : [NSNull null]);
+        }
+    });
+    NSArray *array = [NSArray arrayWithObjects:(__unsafe_unretained id *)(void *)results count:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        CFRelease(results[index]);
+    }
+    free(results);
+    return array;
+}
+
+- (NSArray *)concurrentlyFilteredArrayUsingBlock:(BOOL (^)(id obj))predicate {
+    NSUInteger count = self.count;
+    if (count == 0) {
+        return [NSArray array];
+    }
+
+    // each chunk writes the indexes of its passing elements to the start of its own range in the buffer
+    INChunks chunks = INChunksMake(count, INArrayConcurrentThreshold, 0);
+    NSUInteger *passingIndexes = malloc(count * sizeof(NSUInteger));
+    NSUInteger *passingCounts = calloc(chunks.chunkCount, sizeof(NSUInteger));
+    INChunksEnumerate(chunks, ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        NSUInteger passingCount = 0;
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            if (predicate(self[index])) {
+                passingIndexes[range.location + passingCount++] = index;
+            }
+        }
+        passingCounts[chunk] = passingCount;
+    });
+
+    NSUInteger passingCount = 0;
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    for (NSUInteger chunk = 0; chunk < chunks.chunkCount; chunk++) {
+        const NSUInteger *chunkIndexes = passingIndexes + chunk * chunks.chunkSize;
+        for (NSUInteger position = 0; position < passingCounts[chunk]; position++) {
+            objects[passingCount++] = self[chunkIndexes[position]];
+        }
+    }
+    NSArray *array = [NSArray arrayWithObjects:objects count:passingCount];
+    free(objects);
+    free(passingCounts);
+    free(passingIndexes);
+    return array;
+}
+
+- (id)concurrentlyReducedObjectWithInitialValue:(id)initialValue reduceBlock:(id (^)(id result, id obj))reduceBlock combineBlock:(id (^)(id result, id otherResult))combineBlock {
+    NSUInteger count = self.count;
+    if (count == 0) {
+        return initialValue;
+    }
+
+    // the results of the chunks are retained, so they survive the chunks' autorelease pools
+    INChunks chunks = INChunksMake(count, INArrayConcurrentThreshold, 0);
+    CFTypeRef *chunkResults = calloc(chunks.chunkCount, sizeof(CFTypeRef));
+    INChunksEnumerate(chunks, ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        id result = initialValue;
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            result = reduceBlock(result, self[index]);
+        }
+        chunkResults[chunk] = result != nil ? CFBridgingRetain(result) : NULL;
+    });
+
+    id result = (__bridge id)chunkResults[0];
+    for (NSUInteger chunk = 1; chunk < chunks.chunkCount; chunk++) {
+        result = combineBlock(result, (__bridge id)chunkResults[chunk]);
+    }
+    for (NSUInteger chunk = 0; chunk < chunks.chunkCount; chunk++) {
+        if (chunkResults[chunk] != NULL) {
+            CFRelease(chunkResults[chunk]);
+        }
+    }
+    free(chunkResults);
+    return result;
+}
+
+- (BOOL)anyObjectPassingTest:(BOOL (^)(id obj))predicate {
+    // the threads check the flag after each element, so they stop soon after a match in another chunk
+    atomic_bool found = false;
+    atomic_bool *foundPointer = &found;
+    INChunks chunks = INChunksMake(self.count, INArrayConcurrentThreshold, 0);
+    INChunksEnumerate(chunks, ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            if (atomic_load_explicit(foundPointer, memory_order_relaxed)) {
+                break;
+            }
+            if (predicate(self[index])) {
+                atomic_store_explicit(foundPointer, true, memory_order_relaxed);
+                *stop = YES;
+                break;
+            }
+        }
+    });
+    return atomic_load(&found);
+}
+
+
 @end
@@ -20,6 +20,13 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#import "INDateArithmetic.h"
+#import "INWeekRule.h"
+
+
+@class INTimeZoneTable;
+@class INDateRange;
+
 
 /**
  Detail information about a date.
@@ -58,6 +65,357 @@ typedef struct INDateInformation {
 INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteger day, NSInteger hour, NSInteger minute, NSInteger second);
 
 
+/**
+ Creates a date information struct for a point in time and a fixed offset from GMT.
+ 
+ All fields are calculated arithmetically with the proleptic gregorian calendar, so neither a calendar object nor a lock is needed.
+ The result is the same as NSCalendar's result for all days from the 15th October 1582 on, before NSCalendar switches to the julian calendar.
+ 
+    INDateInformation info = INDateInformationFromTimeInterval(0, 3600);
+    // info: 2001-01-01 01:00:00, weekday = 2
+ 
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @param secondsFromGMT The offset of the wanted time zone, i.e. [timeZone secondsFromGMTForDate:date].
+ @return The date information struct with all fields set.
+ */
+INDateInformation INDateInformationFromTimeInterval(NSTimeInterval timeInterval, NSInteger secondsFromGMT);
+
+
+/**
+ Creates the date information structs for a whole buffer of points in time at once.
+ 
+ This is much faster than creating an NSDate object for each time interval and calling dateInformation on it.
+ The dates are decomposed arithmetically with the gregorian calendar four at a time, only for dates before the 15th October 1582 NSCalendar will be used.
+ Very large buffers will be split up and processed concurrently on all cores, but the function returns only after all structs have been filled.
+ 
+    NSTimeInterval timeIntervals[3] = {0, 86400, 172800};
+    INDateInformation infos[3];
+    INDateInformationFillFromTimeIntervals(timeIntervals, infos, 3, [NSTimeZone timeZoneWithName:@"Europe/Berlin"]);
+ 
+ @param timeIntervals The buffer with the seconds since the reference date 1st January 2001 GMT.
+ @param infos The buffer for the date information structs with at least count elements, all fields will be set.
+ @param count The number of time intervals to decompose.
+ @param timeZone The time zone for the date information structs, if nil the time zone of the cached calendar will be used.
+ */
+void INDateInformationFillFromTimeIntervals(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, NSTimeZone *timeZone);
+
+
+/**
+ Creates the date information structs for a whole buffer of points in time at once in the time zone of a time zone table.
+ 
+ The same as INDateInformationFillFromTimeIntervals(), but the offsets from GMT will be looked up in the precompiled table.
+ 
+ @param timeIntervals The buffer with the seconds since the reference date 1st January 2001 GMT.
+ @param infos The buffer for the date information structs with at least count elements, all fields will be set.
+ @param count The number of time intervals to decompose.
+ @param timeZoneTable The table of the time zone for the date information structs.
+ */
+void INDateInformationFillFromTimeIntervalsWithTimeZoneTable(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, INTimeZoneTable *timeZoneTable);
+
+
+/**
+ Calculates the number of full days, months or years between two buffers of points in time pairwise.
+ 
+ The results are the same as NSCalendar's components:fromDate:toDate:options: with the gregorian calendar returns, but are calculated arithmetically.
+ Only for dates before the 15th October 1582 NSCalendar will be used.
+ Very large buffers will be split up and processed concurrently on all cores, but the function returns only after all differences have been calculated.
+ 
+    NSTimeInterval starts[2] = {0, 0};
+    NSTimeInterval ends[2] = {86400 * 40, -86400 * 40};
+    NSInteger months[2];
+    INDateDifferencesBetweenTimeIntervals(starts, ends, months, 2, NSCalendarUnitMonth, nil);
+    // months: {1, -1}
+ 
+ @param startTimeIntervals The buffer with the start dates as seconds since the reference date 1st January 2001 GMT.
+ @param endTimeIntervals The buffer with the end dates as seconds since the reference date 1st January 2001 GMT.
+ @param differences The buffer for the differences with at least count elements, negative when the end date is before the start date.
+ @param count The number of differences to calculate.
+ @param unit The unit of the differences, either NSCalendarUnitDay, NSCalendarUnitMonth or NSCalendarUnitYear.
+ @param timeZone The time zone for the calculations, if nil the time zone of the cached calendar will be used.
+ */
+void INDateDifferencesBetweenTimeIntervals(const NSTimeInterval *startTimeIntervals, const NSTimeInterval *endTimeIntervals, NSInteger *differences, size_t count, NSCalendarUnit unit, NSTimeZone *timeZone);
+
+
+/**
+ Creates the week information structs for a whole buffer of points in time at once, i.e. for weekly aggregations.
+ 
+ The weeks are calculated arithmetically with the week rule and the proleptic gregorian calendar, no calendar object is involved.
+ Very large buffers will be split up and processed concurrently on all cores, but the function returns only after all structs have been filled.
+ 
+ @param timeIntervals The buffer with the seconds since the reference date 1st January 2001 GMT.
+ @param infos The buffer for the week information structs with at least count elements, all fields will be set.
+ @param count The number of time intervals to calculate the weeks for.
+ @param rule The week rule, i.e. INWeekRuleISO8601.
+ @param timeZone The time zone for the weeks, if nil the time zone of the cached calendar will be used.
+ */
+void INWeekInformationFillFromTimeIntervals(const NSTimeInterval *timeIntervals, INWeekInformation *infos, size_t count, INWeekRule rule, NSTimeZone *timeZone);
+
+
+/**
+ A date and time packed into 64 bits as the days since the 1st January 1970 and the seconds of that day, both local in some time zone.
+ 
+ The days are stored in the upper bits and the seconds of the day in the lower 17 bits, so packed dates can be compared, sorted and deduplicated as plain integers.
+ The days are counted in the proleptic gregorian calendar, so converting to and from INDateInformation needs no calendar object.
+ Like INDateInformation a packed date has no time zone, it will be given when converting from or to NSDate.
+ 
+    INPackedDate date = INPackedDateMake(2016, 2, 28, 12, 0, 0);
+    date = INPackedDateAddDays(date, 1); // 2016-02-29 12:00:00
+ */
+typedef int64_t INPackedDate;
+
+
+/**
+ The factor of the days in a packed date, the lower 17 bits hold the seconds of the day.
+ */
+static const int64_t INPackedDateDayFactor = 1 << 17;
+
+
+/**
+ Creates a packed date out of the days since the 1st January 1970 and the seconds of the day.
+ 
+ @param days The days since the 1st January 1970, negative for days before.
+ @param secondsOfDay The seconds of the day, 0..86399.
+ @return The packed date.
+ */
+static inline INPackedDate INPackedDateMakeWithDays(NSInteger days, NSInteger secondsOfDay) {
+    return (int64_t)days * INPackedDateDayFactor + secondsOfDay;
+}
+
+
+/**
+ Creates a packed date out of a date and time in the gregorian calendar.
+ 
+ The fields may exceed their ranges the same way as with NSCalendar, i.e. the 32nd January is the 1st February.
+ 
+ @param year The year.
+ @param month The month's number.
+ @param day The month's day.
+ @param hour The hour.
+ @param minute The hour's minute.
+ @param second The minute's second.
+ @return The packed date.
+ */
+static inline INPackedDate INPackedDateMake(NSInteger year, NSInteger month, NSInteger day, NSInteger hour, NSInteger minute, NSInteger second) {
+    int64_t seconds = INDateSecondsFromCivil(year, month, day, hour, minute, second);
+    int64_t days = INDateFloorDivide(seconds, INDateSecondsPerDay);
+    return days * INPackedDateDayFactor + (seconds - days * INDateSecondsPerDay);
+}
+
+
+/**
+ Returns the days since the 1st January 1970 of a packed date.
+ 
+ @param date The packed date.
+ @return The days since the 1st January 1970, negative for days before.
+ */
+static inline NSInteger INPackedDateGetDays(INPackedDate date) {
+    return (NSInteger)INDateFloorDivide(date, INPackedDateDayFactor);
+}
+
+
+/**
+ Returns the seconds of the day of a packed date.
+ 
+ @param date The packed date.
+ @return The seconds of the day, 0..86399.
+ */
+static inline NSInteger INPackedDateGetSecondsOfDay(INPackedDate date) {
+    return (NSInteger)(date & (INPackedDateDayFactor - 1));
+}
+
+
+/**
+ Compares two packed dates.
+ 
+ @param date The packed date.
+ @param otherDate The packed date to compare with.
+ @return NSOrderedAscending if date is before otherDate, NSOrderedDescending if it is after otherDate and NSOrderedSame if both are equal.
+ */
+static inline NSComparisonResult INPackedDateCompare(INPackedDate date, INPackedDate otherDate) {
+    return date < otherDate ? NSOrderedAscending : (date > otherDate ? NSOrderedDescending : NSOrderedSame);
+}
+
+
+/**
+ Returns a hash value for a packed date, i.e. for hash tables.
+ 
+ The bits of the packed date are mixed, so dates of successive days or seconds differ in all bits.
+ 
+ @param date The packed date.
+ @return The hash value.
+ */
+static inline NSUInteger INPackedDateHash(INPackedDate date) {
+    uint64_t hash = (uint64_t)date;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return (NSUInteger)(hash ^ (hash >> 31));
+}
+
+
+/**
+ Adds an amount of days to a packed date, the time of the day is kept.
+ 
+ @param date The packed date.
+ @param days The days to add, may be negative.
+ @return The new packed date.
+ */
+static inline INPackedDate INPackedDateAddDays(INPackedDate date, NSInteger days) {
+    return date + (int64_t)days * INPackedDateDayFactor;
+}
+
+
+/**
+ Adds an amount of months to a packed date, the time of the day is kept.
+ 
+ The day of the month is limited to the last day of the resulting month, i.e. the 31st January plus one month is the 28th or 29th February.
+ 
+ @param date The packed date.
+ @param months The months to add, may be negative.
+ @return The new packed date.
+ */
+static inline INPackedDate INPackedDateAddMonths(INPackedDate date, NSInteger months) {
+    NSInteger days = INDateDaysByAddingMonths(INPackedDateGetDays(date), months, NULL);
+    return INPackedDateMakeWithDays(days, INPackedDateGetSecondsOfDay(date));
+}
+
+
+/**
+ Creates a packed date out of a date information struct.
+ 
+ The weekday of the struct is ignored.
+ 
+ @param dateInfo The date information struct.
+ @return The packed date.
+ */
+static inline INPackedDate INPackedDateFromDateInformation(INDateInformation dateInfo) {
+    return INPackedDateMake(dateInfo.year, dateInfo.month, dateInfo.day, dateInfo.hour, dateInfo.minute, dateInfo.second);
+}
+
+
+/**
+ Creates a date information struct out of a packed date.
+ 
+ @param date The packed date.
+ @return The date information struct with all fields set.
+ */
+static inline INDateInformation INDateInformationFromPackedDate(INPackedDate date) {
+    NSInteger days = INPackedDateGetDays(date);
+    NSInteger secondsOfDay = INPackedDateGetSecondsOfDay(date);
+    INDateInformation info;
+    INDateCivilFromDays(days, &info.year, &info.month, &info.day);
+    info.weekday = INDateWeekdayFromDays(days);
+    info.hour = secondsOfDay / 3600;
+    info.minute = secondsOfDay / 60 % 60;
+    info.second = secondsOfDay % 60;
+    return info;
+}
+
+
+/**
+ The steps of enumerating a date range.
+ */
+typedef NS_ENUM(NSInteger, INDateRangeUnit) {
+    /// every day
+    INDateRangeUnitDay,
+    /// every seven days
+    INDateRangeUnitWeek,
+    /// every month, the day of the month is limited to the month's last day
+    INDateRangeUnitMonth,
+    /// every year, the 29th February is limited to the 28th February
+    INDateRangeUnitYear,
+};
+
+
+/**
+ Returns a step of a date range.
+ 
+ Each step is calculated from the start date and not from the previous step, so enumerating months from the 31st January returns the 29th February and then the 31st March.
+ 
+ @param startDate The packed start date of the range.
+ @param unit The unit of the steps.
+ @param index The number of the step, 0 returns the start date.
+ @return The packed date of the step.
+ */
+static inline INPackedDate INDateRangeDateAtIndex(INPackedDate startDate, INDateRangeUnit unit, NSInteger index) {
+    switch (unit) {
+        case INDateRangeUnitDay:
+            return INPackedDateAddDays(startDate, index);
+        case INDateRangeUnitWeek:
+            return INPackedDateAddDays(startDate, index * 7);
+        case INDateRangeUnitMonth:
+            return INPackedDateAddMonths(startDate, index);
+        case INDateRangeUnitYear:
+            return INPackedDateAddMonths(startDate, index * 12);
+    }
+    return startDate;
+}
+
+
+/**
+ Options for formatting durations.
+ */
+typedef NS_OPTIONS(NSUInteger, INDurationFormatOptions) {
+    /// prefixes the duration with + or -, otherwise negative durations are written without a sign
+    INDurationFormatPrintSign = 1 << 0,
+    /// writes HH:MM:SS instead of HH:MM
+    INDurationFormatPrintSeconds = 1 << 1,
+    /// writes only the hours within a day, i.e. 25 hours are written as 01
+    INDurationFormatWrapHours = 1 << 2,
+};
+
+
+/**
+ The maximum length of a string written by INDurationFormatUTF8() without the terminating null character.
+ */
+static const size_t INDurationMaximumLength = 32;
+
+
+/**
+ Formats a duration as [+-]HH:MM[:SS[.fff]] into a UTF-8 buffer without allocating any objects.
+ 
+ The hours are written with at least two digits and are not limited to a day unless INDurationFormatWrapHours is set.
+ Fractions of seconds are truncated and only written together with the seconds.
+ 
+    char buffer[INDurationMaximumLength + 1];
+    INDurationFormatUTF8(-90061.5, INDurationFormatPrintSign | INDurationFormatPrintSeconds, 1, buffer, sizeof(buffer));
+    // buffer: -25:01:01.5
+ 
+ @param seconds The duration in seconds.
+ @param options The options for the format.
+ @param fractionDigits The number of digits for the fractions of seconds, 0..6.
+ @param buffer The buffer to write the null terminated string into.
+ @param bufferSize The size of the buffer, INDurationMaximumLength + 1 is always enough.
+ @return The length of the written string or 0 if the buffer is too small or the duration is not finite or too large.
+ */
+size_t INDurationFormatUTF8(NSTimeInterval seconds, INDurationFormatOptions options, NSUInteger fractionDigits, char *buffer, size_t bufferSize);
+
+
+/**
+ Formats a duration as [+-]HH:MM[:SS[.fff]].
+ 
+ The same as INDurationFormatUTF8(), but returns a new string.
+ 
+ @param seconds The duration in seconds.
+ @param options The options for the format.
+ @param fractionDigits The number of digits for the fractions of seconds, 0..6.
+ @return The formatted string or nil if the duration is not finite or too large.
+ */
+NSString *INDurationStringFromSeconds(NSTimeInterval seconds, INDurationFormatOptions options, NSUInteger fractionDigits);
+
+
+/**
+ Formats a buffer of durations as [+-]HH:MM[:SS[.fff]].
+ 
+ @see INDurationFormatUTF8()
+ @param seconds The durations in seconds.
+ @param count The number of durations.
+ @param options The options for the format.
+ @param fractionDigits The number of digits for the fractions of seconds, 0..6.
+ @return An array with the formatted strings in the same order, durations which can't be formatted result in empty strings.
+ */
+NSArray *INDurationStringsFromSeconds(const NSTimeInterval *seconds, size_t count, INDurationFormatOptions options, NSUInteger fractionDigits);
+
+
 
 @interface NSDate (INExtensions)
 
@@ -68,7 +426,10 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
  Returns a cached gregorian calendar which is used by many methods of this extension.
 
  The default calendar is set up with the current locale.
+ The methods of this extension don't use this calendar directly, but a copy of it for each thread, see threadGregorianCalendar.
  When you want to change any calendar's properties like the locale or the minimum of days in the first week you should do this in a synchronized block guarding the cached calendar.
+ Changes of the time zone, the locale, the first weekday and the minimum of days in the first week are detected by the thread's copies,
+ for changing any other property set a new calendar with setCachedGregorianCalendar:.
 
     NSCalendar *calendar = [NSDate cachedGregorianCalendar];
     @synchronized(calendar) {
@@ -100,6 +461,18 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 + (void)setCachedGregorianCalendar:(NSCalendar *)calendar;
 
 
+/**
+ Returns the calling thread's own copy of the cached gregorian calendar.
+ 
+ Each thread gets its own copy of the cachedGregorianCalendar, so the copy can be used without any lock.
+ The copy will be replaced automatically when a new calendar is set with setCachedGregorianCalendar: or when the time zone, locale, first weekday or minimum days in the first week of the cached calendar have been changed.
+ Never change any properties of the returned calendar, change the cachedGregorianCalendar instead.
+ 
+ @return The calendar for the current thread.
+ */
++ (NSCalendar *)threadGregorianCalendar;
+
+
 #pragma mark - DateInformation
 /// @name DateInformation
 
@@ -107,6 +480,7 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
  Creates a date information struct from this NSDate.
  
  This method initializes the struct fully with all components.
+ When the cached calendar is a gregorian one the fields will be calculated arithmetically without locking the calendar.
  Same as:
  
     NSUInteger components = NSCalendarUnitMonth | NSCalendarUnitMinute | NSCalendarUnitYear | NSCalendarUnitDay | NSCalendarUnitWeekday | NSCalendarUnitHour | NSCalendarUnitSecond;
@@ -129,6 +503,19 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 - (INDateInformation)dateInformationForComponents:(NSCalendarUnit)components;
 
 
+/**
+ Creates a date information struct from this NSDate in the time zone of a time zone table.
+ 
+ The offset from GMT will be looked up in the table and the fields will be calculated arithmetically,
+ so this is much faster than using NSCalendar when the dates are in any time zone with daylight saving time.
+ Neither the cached calendar nor its time zone will be used.
+ 
+ @param timeZoneTable The table of the time zone for the date information.
+ @return The date information struct with all fields set.
+ */
+- (INDateInformation)dateInformationWithTimeZoneTable:(INTimeZoneTable *)timeZoneTable;
+
+
 /**
  Creates a new NSDate out of a date information struct.
  
@@ -154,6 +541,63 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 + (NSDate *)dateWithDateInformation:(INDateInformation)dateInfo timeZone:(NSTimeZone *)timeZone;
 
 
+/**
+ Creates a new NSDate out of a date information struct in context of a time zone table.
+ 
+ The same as dateWithDateInformation:timeZone: with the table's time zone, but the local time is converted arithmetically with the table's precompiled offsets.
+ Local times skipped when switching to daylight saving time are moved forward and local times which occur twice resolve to the first occurrence.
+ 
+ @param dateInfo The date information struct.
+ @param timeZoneTable The table of the time zone for the date info data.
+ @return The new NSDate object.
+ */
++ (NSDate *)dateWithDateInformation:(INDateInformation)dateInfo timeZoneTable:(INTimeZoneTable *)timeZoneTable;
+
+
+#pragma mark - PackedDate
+/// @name PackedDate
+
+/**
+ Creates a packed date from this NSDate in the time zone of the cached calendar.
+ 
+ The date is converted arithmetically without any calendar, fractions of seconds are truncated.
+ Before the 15th October 1582 the packed date's days follow the proleptic gregorian calendar and not NSCalendar's julian calendar.
+ 
+ @return The packed date.
+ */
+- (INPackedDate)packedDate;
+
+
+/**
+ Creates a packed date from this NSDate in a given time zone.
+ 
+ @param timeZone The time zone for the packed date, if nil the time zone of the cached calendar will be used.
+ @return The packed date.
+ */
+- (INPackedDate)packedDateWithTimeZone:(NSTimeZone *)timeZone;
+
+
+/**
+ Creates a new NSDate out of a packed date in the time zone of the cached calendar.
+ 
+ Local times skipped when switching to daylight saving time are moved forward and local times which occur twice resolve to the first occurrence, the same as with dateWithDateInformation:.
+ 
+ @param packedDate The packed date.
+ @return The new NSDate object.
+ */
++ (NSDate *)dateWithPackedDate:(INPackedDate)packedDate;
+
+
+/**
+ Creates a new NSDate out of a packed date in a given time zone.
+ 
+ @param packedDate The packed date.
+ @param timeZone The time zone of the packed date, if nil the time zone of the cached calendar will be used.
+ @return The new NSDate object.
+ */
++ (NSDate *)dateWithPackedDate:(INPackedDate)packedDate timeZone:(NSTimeZone *)timeZone;
+
+
 #pragma mark - Date initializers
 /// @name Date initializers
 
@@ -214,6 +658,8 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 /**
  Converts a time in seconds into a printable string.
  
+ Only the hours within a day are written, use INDurationStringFromSeconds() for durations of more than 24 hours.
+ 
  @param seconds The number of seconds which represents the new time.
  @param printSign If true the string will have a sign + or - as prefix, depending if the seconds are positive or negative.
  @param printSeconds The output string will be in the form of HH:MM:SS if printSeconds is true, otherwise it will be of the form HH:MM.
@@ -316,6 +762,8 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 
 /**
  Creates a date with the month incremented by one.
+
+ The time is kept, but if the day does not exist in the new month the new month's last day with the time zeroed is returned.
  
  @return A new date object.
  */
@@ -324,6 +772,8 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 
 /**
  Creates a date with the month decremented by one.
+
+ The time is kept, but if the day does not exist in the new month the new month's last day with the time zeroed is returned.
  
  @return A new date object.
  */
@@ -390,11 +840,38 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
         [calendar setMinimumDaysInFirstWeek:4]; // 4 days in the year's first week
     }
 
+ When the cached calendar is a gregorian one the week will be calculated arithmetically with the calendar's rule, see weekNumberOfYearWithRule:.
+ 
  @return The week as a number.
  */
 - (NSInteger)weekNumberOfYear;
 
 
+/**
+ Returns the week number of the year with an explicit week rule in the time zone of the cached calendar.
+ 
+ The week is calculated arithmetically and doesn't depend on the cached calendar's first weekday or locale.
+ 
+    NSInteger week = [date weekNumberOfYearWithRule:INWeekRuleISO8601];
+ 
+ @param rule The week rule.
+ @return The week as a number, 1..53.
+ @see weekYearWithRule:
+ */
+- (NSInteger)weekNumberOfYearWithRule:(INWeekRule)rule;
+
+
+/**
+ Returns the year the week of this date belongs to with an explicit week rule in the time zone of the cached calendar.
+ 
+ The first days of a year may belong to the last week of the previous year and the last days to the first week of the next year.
+ 
+ @param rule The week rule.
+ @return The year of the week.
+ */
+- (NSInteger)weekYearWithRule:(INWeekRule)rule;
+
+
 /**
  Returns the week number of the month, i.e. 4.
  
@@ -406,6 +883,17 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 - (NSInteger)weekNumberOfMonth;
 
 
+/**
+ Returns the week number of the month with an explicit week rule in the time zone of the cached calendar.
+ 
+ Days before the first week of the month are in week 0.
+ 
+ @param rule The week rule.
+ @return The week as a number, 0..6.
+ */
+- (NSInteger)weekNumberOfMonthWithRule:(INWeekRule)rule;
+
+
 /**
  Returns the day number of the month, i.e. 31 for January the 31st.
  
@@ -469,6 +957,7 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
  Returns the number of years between this and the other date.
  
  Counts only full years.
+ When the cached calendar is a gregorian one the difference will be calculated arithmetically without locking the calendar.
  Returns a negative number if the other date is before this one.
  
  @param otherDate The other date to compare with.
@@ -481,6 +970,7 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
  Returns the number of months between this and the other date.
  
  Counts only full months.
+ When the cached calendar is a gregorian one the difference will be calculated arithmetically without locking the calendar.
  Returns a negative number if the other date is before this one.
  
  @param otherDate The other date to compare with.
@@ -493,6 +983,7 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
  Returns the number of days between this and the other date.
  
  Counts only full days.
+ When the cached calendar is a gregorian one the difference will be calculated arithmetically without locking the calendar.
  Returns a negative numbers if the other date is before this one.
  
  @param otherDate The other date to compare with.
@@ -501,4 +992,100 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 - (NSInteger)daysBetweenDate:(NSDate *)otherDate;
 
 
+#pragma mark - Date ranges
+/// @name Date ranges
+
+/**
+ Enumerates all days, weeks, months or years from this date until the end date in the time zone of the cached calendar.
+ 
+ The dates are calculated one by one as packed dates without creating any objects, so the memory stays constant no matter how long the range is.
+ Each step keeps the local time of this date, the end date is included when a step hits it.
+ 
+    [startDate enumerateDatesUntilDate:endDate unit:INDateRangeUnitDay usingBlock:^(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop) {
+        NSLog(@"%ld.%ld.%ld", (long)dateInfo.day, (long)dateInfo.month, (long)dateInfo.year);
+    }];
+ 
+ @param endDate The last date of the range, if it is before this date the block won't be called.
+ @param unit The unit of the steps.
+ @param block The block called for each step with the step's packed date and its date information, set stop to YES to end the enumeration.
+ */
+- (void)enumerateDatesUntilDate:(NSDate *)endDate unit:(INDateRangeUnit)unit usingBlock:(void (^)(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop))block;
+
+
+/**
+ Creates a date range from this date until the end date in the time zone of the cached calendar.
+ 
+ The range can be used with fast enumeration, see INDateRange.
+ 
+ @param endDate The last date of the range.
+ @param unit The unit of the steps.
+ @return The new date range.
+ */
+- (INDateRange *)dateRangeUntilDate:(NSDate *)endDate unit:(INDateRangeUnit)unit;
+
+
+@end
+
+
+
+/**
+ A range of dates, which calculates its steps lazily while enumerating.
+ 
+ The range supports fast enumeration, which returns NSNumber objects with the packed dates as long long values.
+ Only a small buffer of numbers is held at a time, so the memory stays constant no matter how long the range is.
+ 
+    INDateRange *range = [startDate dateRangeUntilDate:endDate unit:INDateRangeUnitWeek];
+    for (NSNumber *number in range) {
+        INDateInformation dateInfo = INDateInformationFromPackedDate([number longLongValue]);
+    }
+ */
+@interface INDateRange : NSObject <NSFastEnumeration>
+
+/**
+ The packed start date of the range.
+ */
+@property (nonatomic, assign, readonly) INPackedDate startDate;
+
+/**
+ The packed end date of the range, which is included.
+ */
+@property (nonatomic, assign, readonly) INPackedDate endDate;
+
+/**
+ The unit of the range's steps.
+ */
+@property (nonatomic, assign, readonly) INDateRangeUnit unit;
+
+
+/**
+ Creates a date range.
+ 
+ @see initWithStartDate:endDate:unit:
+ @param startDate The packed start date of the range.
+ @param endDate The packed end date of the range, which is included when a step hits it.
+ @param unit The unit of the range's steps.
+ @return The new date range.
+ */
++ (instancetype)rangeWithStartDate:(INPackedDate)startDate endDate:(INPackedDate)endDate unit:(INDateRangeUnit)unit;
+
+
+/**
+ Initializes a date range.
+ 
+ @param startDate The packed start date of the range.
+ @param endDate The packed end date of the range, which is included when a step hits it.
+ @param unit The unit of the range's steps.
+ @return The initialized date range.
+ */
+- (instancetype)initWithStartDate:(INPackedDate)startDate endDate:(INPackedDate)endDate unit:(INDateRangeUnit)unit;
+
+
+/**
+ Enumerates all steps of the range.
+ 
+ @param block The block called for each step with the step's packed date and its date information, set stop to YES to end the enumeration.
+ */
+- (void)enumerateDatesUsingBlock:(void (^)(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop))block;
+
+
 @end
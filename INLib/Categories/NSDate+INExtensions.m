@@ -23,6 +23,12 @@
 
 #import "NSDate+INExtensions.h"
 #import "NSDateFormatter+INExtensions.h"
+#import "INDateArithmetic.h"
+#import "INWeekRule.h"
+#import "INTimeZoneTable.h"
+#import "INConcurrentChunks.h"
+#import <stdatomic.h>
+#import <pthread.h>
 
 
 INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteger day, NSInteger hour, NSInteger minute, NSInteger second) {
@@ -37,6 +43,20 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
     return info;
 }
 
+INDateInformation INDateInformationFromTimeInterval(NSTimeInterval timeInterval, NSInteger secondsFromGMT) {
+    int64_t localSeconds = (int64_t)floor(timeInterval) + (int64_t)NSTimeIntervalSince1970 + secondsFromGMT;
+    int64_t days = INDateFloorDivide(localSeconds, INDateSecondsPerDay);
+    NSInteger secondsOfDay = (NSInteger)(localSeconds - days * INDateSecondsPerDay);
+
+    INDateInformation info;
+    INDateCivilFromDays((NSInteger)days, &info.year, &info.month, &info.day);
+    info.weekday = INDateWeekdayFromDays((NSInteger)days);
+    info.hour = secondsOfDay / 3600;
+    info.minute = secondsOfDay / 60 % 60;
+    info.second = secondsOfDay % 60;
+    return info;
+}
+
 
 // private declarations
 @interface NSDate (INExtension)
@@ -46,9 +66,517 @@ INDateInformation INDateInformationMake(NSInteger year, NSInteger month, NSInteg
 @end
 
 
+// A thread's own copy of the cached calendar together with the cached calendar's state when it has been copied.
+@interface INThreadCalendar : NSObject
+
+@property (nonatomic, strong, readonly) NSCalendar *calendar;
+@property (nonatomic, assign, readonly) NSUInteger generation;
+
+- (instancetype)initWithCalendar:(NSCalendar *)calendar generation:(NSUInteger)generation;
+- (BOOL)isCopyOfCalendar:(NSCalendar *)calendar generation:(NSUInteger)generation;
+
+@end
+
+
+@implementation INThreadCalendar {
+    // the copied properties which may be changed on the cached calendar directly without setting a new one
+    NSTimeZone *_timeZone;
+    NSLocale *_locale;
+    NSUInteger _firstWeekday;
+    NSUInteger _minimumDaysInFirstWeek;
+}
+
+- (instancetype)initWithCalendar:(NSCalendar *)calendar generation:(NSUInteger)generation {
+    self = [super init];
+    if (self == nil) return self;
+    @synchronized(calendar) {
+        _calendar = [calendar copy];
+    }
+    _generation = generation;
+    _timeZone = _calendar.timeZone;
+    _locale = _calendar.locale;
+    _firstWeekday = _calendar.firstWeekday;
+    _minimumDaysInFirstWeek = _calendar.minimumDaysInFirstWeek;
+    return self;
+}
+
+- (BOOL)isCopyOfCalendar:(NSCalendar *)calendar generation:(NSUInteger)generation {
+    if (generation != _generation || calendar.firstWeekday != _firstWeekday || calendar.minimumDaysInFirstWeek != _minimumDaysInFirstWeek) {
+        return NO;
+    }
+    NSTimeZone *timeZone = calendar.timeZone;
+    if (timeZone != _timeZone && ![timeZone isEqualToTimeZone:_timeZone]) {
+        return NO;
+    }
+    NSLocale *locale = calendar.locale;
+    return locale == _locale || [locale isEqual:_locale];
+}
+
+@end
+
+
+// key for the current thread's INThreadCalendar in the thread dictionary
+static NSString * const INThreadCalendarKey = @"INExtensions_threadCalendar";
+
+// incremented each time a new calendar is cached, so each thread knows when to replace its copy
+static atomic_uint __cachedCalendarGeneration = 0;
+
+
 // use a static gregorian calendar for performance purposes because creating it at runtime is time expensive
 static NSCalendar *__defaultCachedGregorianCalendar = nil;
 
+// true if the cached calendar is a gregorian one, so the date's fields can be calculated arithmetically
+static atomic_bool __cachedCalendarIsGregorian = true;
+
+// Reads the gregorian flag with acquire ordering, so it pairs with the release store in setCachedGregorianCalendar:.
+static inline BOOL INCachedCalendarIsGregorian(void) {
+    return atomic_load_explicit(&__cachedCalendarIsGregorian, memory_order_acquire);
+}
+
+
+// Returns true if the arithmetic calculations return the same as NSCalendar for the time interval since the reference date.
+// One day is left as tolerance on both ends for the time zone offset.
+static inline BOOL INDateArithmeticSupportsTimeInterval(NSTimeInterval timeInterval) {
+    NSTimeInterval secondsSince1970 = timeInterval + NSTimeIntervalSince1970;
+    return secondsSince1970 >= (INDateGregorianCutoverDay + 1) * (NSTimeInterval)INDateSecondsPerDay
+        && secondsSince1970 < (INDateArithmeticMaximumDay - 1) * (NSTimeInterval)INDateSecondsPerDay;
+}
+
+// Calculates the date information of a date arithmetically in the cached calendar's time zone without locking the calendar.
+// Returns false when NSCalendar has to be used instead, because the cached calendar is no gregorian one or the date is out of range.
+static inline BOOL INArithmeticDateInformation(NSDate *date, INDateInformation *info) {
+    NSTimeInterval timeInterval = [date timeIntervalSinceReferenceDate];
+    if (date == nil || !INCachedCalendarIsGregorian() || !INDateArithmeticSupportsTimeInterval(timeInterval)) {
+        return NO;
+    }
+    CFTimeZoneRef timeZone = (__bridge CFTimeZoneRef)[[NSDate cachedGregorianCalendar] timeZone];
+    *info = INDateInformationFromTimeInterval(timeInterval, (NSInteger)CFTimeZoneGetSecondsFromGMT(timeZone, timeInterval));
+    return YES;
+}
+
+// Splits a date into the days since 1970 and the seconds of the day in the cached calendar's time zone.
+// Returns false when NSCalendar has to be used instead, the same as INArithmeticDateInformation().
+static inline BOOL INArithmeticLocalDays(NSDate *date, NSInteger *days, NSInteger *secondsOfDay) {
+    NSTimeInterval timeInterval = [date timeIntervalSinceReferenceDate];
+    if (date == nil || !INCachedCalendarIsGregorian() || !INDateArithmeticSupportsTimeInterval(timeInterval)) {
+        return NO;
+    }
+    CFTimeZoneRef timeZone = (__bridge CFTimeZoneRef)[[NSDate cachedGregorianCalendar] timeZone];
+    int64_t localSeconds = (int64_t)floor(timeInterval) + (int64_t)NSTimeIntervalSince1970 + CFTimeZoneGetSecondsFromGMT(timeZone, timeInterval);
+    int64_t localDays = INDateFloorDivide(localSeconds, INDateSecondsPerDay);
+    *days = (NSInteger)localDays;
+    *secondsOfDay = (NSInteger)(localSeconds - localDays * INDateSecondsPerDay);
+    return YES;
+}
+
+// Returns the week settings of the cached calendar, read from the shared calendar without looking up the thread's copy.
+static inline INWeekRule INCachedCalendarWeekRule(void) {
+    NSCalendar *calendar = [NSDate cachedGregorianCalendar];
+    return INWeekRuleMake(calendar.firstWeekday, calendar.minimumDaysInFirstWeek);
+}
+
+// INDateOffsetFunction returning the offsets of the CFTimeZone given as context
+static NSInteger INDateTimeZoneOffsetFunction(const void *context, NSTimeInterval timeInterval) {
+    return (NSInteger)CFTimeZoneGetSecondsFromGMT((CFTimeZoneRef)context, timeInterval);
+}
+
+// Creates the date for a local day and time in the cached calendar's time zone without NSDateComponents.
+// Returns nil when NSCalendar has to be used instead, because the day is out of range.
+static inline NSDate *INArithmeticDateFromLocalDays(NSInteger days, NSTimeInterval secondsOfDay) {
+    NSTimeInterval localTimeInterval = (NSTimeInterval)days * INDateSecondsPerDay + secondsOfDay - NSTimeIntervalSince1970;
+    if (!INDateArithmeticSupportsTimeInterval(localTimeInterval)) {
+        return nil;
+    }
+    CFTimeZoneRef timeZone = (__bridge CFTimeZoneRef)[[NSDate cachedGregorianCalendar] timeZone];
+    NSTimeInterval timeInterval = INDateTimeIntervalFromLocalTimeInterval(localTimeInterval, INDateTimeZoneOffsetFunction, timeZone);
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval];
+}
+
+
+// the range of today [start, end) in the cached calendar's time zone, guarded by a sequence lock so it can be read without locking
+// the sequence is odd while the range is written
+static atomic_uint __todaySequence = 0;
+static _Atomic(NSTimeInterval) __todayStart = 0;
+static _Atomic(NSTimeInterval) __todayEnd = 0;
+// the address of the time zone the range has been calculated for
+static _Atomic(uintptr_t) __todayTimeZone = 0;
+// keeps the time zone of the range alive, so no other time zone can get its address
+static NSTimeZone *__todayTimeZoneReference = nil;
+// serializes the writers of the range
+static pthread_mutex_t __todayMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Stores the range of today for the time zone.
+static void INDateStoreToday(NSTimeInterval start, NSTimeInterval end, NSTimeZone *timeZone) {
+    pthread_mutex_lock(&__todayMutex);
+    unsigned int sequence = atomic_load_explicit(&__todaySequence, memory_order_relaxed);
+    atomic_store_explicit(&__todaySequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&__todayStart, start, memory_order_relaxed);
+    atomic_store_explicit(&__todayEnd, end, memory_order_relaxed);
+    atomic_store_explicit(&__todayTimeZone, (uintptr_t)timeZone, memory_order_relaxed);
+    __todayTimeZoneReference = timeZone;
+    atomic_store_explicit(&__todaySequence, sequence + 2, memory_order_release);
+    pthread_mutex_unlock(&__todayMutex);
+}
+
+// Forces the range of today to be recalculated, i.e. after the system's time zone or clock has changed.
+static void INDateInvalidateToday(void) {
+    INDateStoreToday(0, 0, nil);
+}
+
+// Reads a consistent copy of the range of today.
+static inline void INDateLoadToday(NSTimeInterval *start, NSTimeInterval *end, uintptr_t *timeZone) {
+    unsigned int sequence;
+    do {
+        sequence = atomic_load_explicit(&__todaySequence, memory_order_acquire);
+        *start = atomic_load_explicit(&__todayStart, memory_order_relaxed);
+        *end = atomic_load_explicit(&__todayEnd, memory_order_relaxed);
+        *timeZone = atomic_load_explicit(&__todayTimeZone, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((sequence & 1) != 0 || sequence != atomic_load_explicit(&__todaySequence, memory_order_relaxed));
+}
+
+// Returns the range of today in the cached calendar's time zone, which will be recalculated only after midnight or when the time zone has changed.
+// Returns false when NSCalendar has to be used instead, the same as INArithmeticDateInformation().
+static BOOL INArithmeticToday(NSTimeInterval *start, NSTimeInterval *end) {
+    if (!INCachedCalendarIsGregorian()) {
+        return NO;
+    }
+    NSTimeZone *timeZone = [[NSDate cachedGregorianCalendar] timeZone];
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    uintptr_t cachedTimeZone;
+    INDateLoadToday(start, end, &cachedTimeZone);
+    if (cachedTimeZone == (uintptr_t)timeZone && now >= *start && now < *end) {
+        return YES;
+    }
+    if (!INDateArithmeticSupportsTimeInterval(now)) {
+        return NO;
+    }
+
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // the offsets of the system's time zone or the clock may change without passing midnight
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        for (NSString *name in @[NSSystemTimeZoneDidChangeNotification, UIApplicationSignificantTimeChangeNotification]) {
+            [center addObserverForName:name object:nil queue:nil usingBlock:^(NSNotification *note) {
+                INDateInvalidateToday();
+            }];
+        }
+    });
+
+    CFTimeZoneRef cfTimeZone = (__bridge CFTimeZoneRef)timeZone;
+    int64_t localSeconds = (int64_t)floor(now) + (int64_t)NSTimeIntervalSince1970 + CFTimeZoneGetSecondsFromGMT(cfTimeZone, now);
+    NSTimeInterval localStart = (NSTimeInterval)INDateFloorDivide(localSeconds, INDateSecondsPerDay) * INDateSecondsPerDay - NSTimeIntervalSince1970;
+    *start = INDateTimeIntervalFromLocalTimeInterval(localStart, INDateTimeZoneOffsetFunction, cfTimeZone);
+    *end = INDateTimeIntervalFromLocalTimeInterval(localStart + INDateSecondsPerDay, INDateTimeZoneOffsetFunction, cfTimeZone);
+    INDateStoreToday(*start, *end, timeZone);
+    return YES;
+}
+
+
+// number of dates which are decomposed together with buffers on the stack
+#define INDateBatchSize 256
+
+// number of dates from which on the decomposition will be split across all cores
+static const size_t INDateConcurrentBatchThreshold = 1 << 16;
+
+// four unsigned 32 bit integers for decomposing four dates at once
+typedef uint32_t INDateVector __attribute__((vector_size(16)));
+
+// Converts four days counted from the 1st March 0000 into gregorian dates at once.
+// The same algorithm as INDateCivilFromDays(), but without branches and only valid for positive days, so it can be vectorized.
+static inline void INDateCivilFromShiftedDaysVector(INDateVector shiftedDays, INDateVector *year, INDateVector *month, INDateVector *day, INDateVector *weekday) {
+    INDateVector era = shiftedDays / 146097;
+    INDateVector dayOfEra = shiftedDays - era * 146097;
+    INDateVector yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    INDateVector dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    INDateVector shiftedMonth = (5 * dayOfYear + 2) / 153;
+    *day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    *month = shiftedMonth + 3 - ((INDateVector)(shiftedMonth >= 10) & 12);
+    *year = yearOfEra + era * 400 + ((INDateVector)(*month <= 2) & 1);
+    // the 1st March 0000 was a Wednesday
+    *weekday = (shiftedDays + 3) % 7 + 1;
+}
+
+// Decomposes up to INDateBatchSize time intervals, dates out of the arithmetic's range will be calculated by the fallback calendar.
+static void INDateInformationFillBatch(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, NSTimeZone *timeZone, INTimeZoneTable *timeZoneTable, NSCalendar * __strong *fallbackCalendar) {
+    CFTimeZoneRef cfTimeZone = (__bridge CFTimeZoneRef)timeZone;
+    INDateVector shiftedDays[INDateBatchSize / 4];
+    uint32_t secondsOfDay[INDateBatchSize];
+    BOOL needsCalendar = NO;
+
+    // collect the local days and times, the time zone offset can't be vectorized
+    for (size_t index = 0; index < count; index++) {
+        NSTimeInterval timeInterval = timeIntervals[index];
+        if (!INDateArithmeticSupportsTimeInterval(timeInterval)) {
+            needsCalendar = YES;
+            // any valid day, will be overwritten
+            shiftedDays[index / 4][index % 4] = 719468;
+            secondsOfDay[index] = 0;
+            continue;
+        }
+        int64_t secondsFromGMT = timeZoneTable != nil ? [timeZoneTable secondsFromGMTForTimeInterval:timeInterval] : (int64_t)CFTimeZoneGetSecondsFromGMT(cfTimeZone, timeInterval);
+        int64_t localSeconds = (int64_t)floor(timeInterval) + (int64_t)NSTimeIntervalSince1970 + secondsFromGMT;
+        int64_t days = INDateFloorDivide(localSeconds, INDateSecondsPerDay);
+        shiftedDays[index / 4][index % 4] = (uint32_t)(days + 719468);
+        secondsOfDay[index] = (uint32_t)(localSeconds - days * INDateSecondsPerDay);
+    }
+    for (size_t index = count; index % 4 != 0; index++) {
+        shiftedDays[index / 4][index % 4] = 719468;
+    }
+
+    // decompose the days four at a time
+    for (size_t vectorIndex = 0; vectorIndex * 4 < count; vectorIndex++) {
+        INDateVector year, month, day, weekday;
+        INDateCivilFromShiftedDaysVector(shiftedDays[vectorIndex], &year, &month, &day, &weekday);
+        for (size_t lane = 0; lane < 4 && vectorIndex * 4 + lane < count; lane++) {
+            size_t index = vectorIndex * 4 + lane;
+            INDateInformation *info = &infos[index];
+            info->year = year[lane];
+            info->month = month[lane];
+            info->day = day[lane];
+            info->weekday = weekday[lane];
+            info->hour = secondsOfDay[index] / 3600;
+            info->minute = secondsOfDay[index] / 60 % 60;
+            info->second = secondsOfDay[index] % 60;
+        }
+    }
+
+    if (!needsCalendar) {
+        return;
+    }
+    for (size_t index = 0; index < count; index++) {
+        if (INDateArithmeticSupportsTimeInterval(timeIntervals[index])) {
+            continue;
+        }
+        if (*fallbackCalendar == nil) {
+            *fallbackCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+            (*fallbackCalendar).timeZone = timeZone;
+        }
+        NSUInteger components = NSCalendarUnitMonth | NSCalendarUnitMinute | NSCalendarUnitYear | NSCalendarUnitDay | NSCalendarUnitWeekday | NSCalendarUnitHour | NSCalendarUnitSecond;
+        NSDateComponents *comps = [*fallbackCalendar components:components fromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:timeIntervals[index]]];
+        infos[index] = INDateInformationMake(comps.year, comps.month, comps.day, comps.hour, comps.minute, comps.second);
+        infos[index].weekday = comps.weekday;
+    }
+}
+
+// Decomposes any number of time intervals serially.
+static void INDateInformationFillSerially(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, NSTimeZone *timeZone, INTimeZoneTable *timeZoneTable) {
+    NSCalendar *fallbackCalendar = nil;
+    for (size_t start = 0; start < count; start += INDateBatchSize) {
+        size_t batchCount = MIN((size_t)INDateBatchSize, count - start);
+        INDateInformationFillBatch(timeIntervals + start, infos + start, batchCount, timeZone, timeZoneTable, &fallbackCalendar);
+    }
+}
+
+// Decomposes any number of time intervals, either with the time zone table or if nil with the time zone.
+static void INDateInformationFill(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, NSTimeZone *timeZone, INTimeZoneTable *timeZoneTable) {
+    INChunksEnumerate(INChunksMake(count, INDateConcurrentBatchThreshold, 0), ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        INDateInformationFillSerially(timeIntervals + range.location, infos + range.location, range.length, timeZone, timeZoneTable);
+    });
+}
+
+void INDateInformationFillFromTimeIntervals(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, NSTimeZone *timeZone) {
+    if (timeZone == nil) {
+        timeZone = [[NSDate cachedGregorianCalendar] timeZone];
+    }
+    INDateInformationFill(timeIntervals, infos, count, timeZone, nil);
+}
+
+void INDateInformationFillFromTimeIntervalsWithTimeZoneTable(const NSTimeInterval *timeIntervals, INDateInformation *infos, size_t count, INTimeZoneTable *timeZoneTable) {
+    INDateInformationFill(timeIntervals, infos, count, timeZoneTable.timeZone, timeZoneTable);
+}
+
+
+// Returns the number of full days, months or years from the start until the end the same way as NSCalendar does,
+// which is the largest number of units that can be added to the start without passing the end.
+// Both time intervals have to be supported by the arithmetic calculations.
+static NSInteger INDateDifference(NSTimeInterval startTimeInterval, NSTimeInterval endTimeInterval, NSCalendarUnit unit, CFTimeZoneRef timeZone) {
+    NSTimeInterval localStart = startTimeInterval + NSTimeIntervalSince1970 + CFTimeZoneGetSecondsFromGMT(timeZone, startTimeInterval);
+    NSTimeInterval localEnd = endTimeInterval + NSTimeIntervalSince1970 + CFTimeZoneGetSecondsFromGMT(timeZone, endTimeInterval);
+    NSInteger startDays = (NSInteger)floor(localStart / INDateSecondsPerDay);
+    NSInteger endDays = (NSInteger)floor(localEnd / INDateSecondsPerDay);
+    NSTimeInterval startTimeOfDay = localStart - (NSTimeInterval)startDays * INDateSecondsPerDay;
+
+    // estimate by the calendar fields, which is at most one unit too far when the end's day or time is before the start's one
+    NSInteger difference = endDays - startDays;
+    NSInteger monthsPerUnit = unit == NSCalendarUnitYear ? 12 : 1;
+    if (unit != NSCalendarUnitDay) {
+        NSInteger startYear, startMonth, startDay, endYear, endMonth, endDay;
+        INDateCivilFromDays(startDays, &startYear, &startMonth, &startDay);
+        INDateCivilFromDays(endDays, &endYear, &endMonth, &endDay);
+        difference = (endYear * 12 + endMonth - startYear * 12 - startMonth) / monthsPerUnit;
+    }
+
+    // step back until adding the difference to the start doesn't pass the end
+    while (difference != 0) {
+        NSInteger days = unit == NSCalendarUnitDay ? startDays + difference : INDateDaysByAddingMonths(startDays, difference * monthsPerUnit, NULL);
+        NSTimeInterval localTimeInterval = (NSTimeInterval)days * INDateSecondsPerDay + startTimeOfDay - NSTimeIntervalSince1970;
+        NSTimeInterval timeInterval = INDateTimeIntervalFromLocalTimeInterval(localTimeInterval, INDateTimeZoneOffsetFunction, timeZone);
+        if (difference > 0 ? timeInterval <= endTimeInterval : timeInterval >= endTimeInterval) {
+            break;
+        }
+        difference += difference > 0 ? -1 : 1;
+    }
+    return difference;
+}
+
+// Calculates the difference between two dates arithmetically in the cached calendar's time zone without locking the calendar.
+// Returns false when NSCalendar has to be used instead, the same as INArithmeticDateInformation().
+static inline BOOL INArithmeticDateDifference(NSDate *date, NSDate *otherDate, NSCalendarUnit unit, NSInteger *difference) {
+    NSTimeInterval timeInterval = [date timeIntervalSinceReferenceDate];
+    NSTimeInterval otherTimeInterval = [otherDate timeIntervalSinceReferenceDate];
+    if (date == nil || otherDate == nil || !INCachedCalendarIsGregorian() || !INDateArithmeticSupportsTimeInterval(timeInterval) || !INDateArithmeticSupportsTimeInterval(otherTimeInterval)) {
+        return NO;
+    }
+    CFTimeZoneRef timeZone = (__bridge CFTimeZoneRef)[[NSDate cachedGregorianCalendar] timeZone];
+    *difference = INDateDifference(timeInterval, otherTimeInterval, unit, timeZone);
+    return YES;
+}
+
+void INDateDifferencesBetweenTimeIntervals(const NSTimeInterval *startTimeIntervals, const NSTimeInterval *endTimeIntervals, NSInteger *differences, size_t count, NSCalendarUnit unit, NSTimeZone *timeZone) {
+    NSCAssert(unit == NSCalendarUnitDay || unit == NSCalendarUnitMonth || unit == NSCalendarUnitYear, @"Only days, months or years are supported");
+    if (timeZone == nil) {
+        timeZone = [[NSDate cachedGregorianCalendar] timeZone];
+    }
+    CFTimeZoneRef cfTimeZone = (__bridge CFTimeZoneRef)timeZone;
+    INChunksEnumerate(INChunksMake(count, INDateConcurrentBatchThreshold, 0), ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        NSCalendar *fallbackCalendar = nil;
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            NSTimeInterval startTimeInterval = startTimeIntervals[index];
+            NSTimeInterval endTimeInterval = endTimeIntervals[index];
+            if (INDateArithmeticSupportsTimeInterval(startTimeInterval) && INDateArithmeticSupportsTimeInterval(endTimeInterval)) {
+                differences[index] = INDateDifference(startTimeInterval, endTimeInterval, unit, cfTimeZone);
+                continue;
+            }
+            if (fallbackCalendar == nil) {
+                fallbackCalendar = [[NSCalendar alloc] initWithCalendarIdentifier:NSCalendarIdentifierGregorian];
+                fallbackCalendar.timeZone = timeZone;
+            }
+            NSDateComponents *comps = [fallbackCalendar components:unit fromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:startTimeInterval] toDate:[NSDate dateWithTimeIntervalSinceReferenceDate:endTimeInterval] options:0];
+            differences[index] = unit == NSCalendarUnitDay ? comps.day : (unit == NSCalendarUnitMonth ? comps.month : comps.year);
+        }
+    });
+}
+
+void INWeekInformationFillFromTimeIntervals(const NSTimeInterval *timeIntervals, INWeekInformation *infos, size_t count, INWeekRule rule, NSTimeZone *timeZone) {
+    if (timeZone == nil) {
+        timeZone = [[NSDate cachedGregorianCalendar] timeZone];
+    }
+    CFTimeZoneRef cfTimeZone = (__bridge CFTimeZoneRef)timeZone;
+    INChunksEnumerate(INChunksMake(count, INDateConcurrentBatchThreshold, 0), ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            NSTimeInterval timeInterval = timeIntervals[index];
+            int64_t localSeconds = (int64_t)floor(timeInterval) + (int64_t)NSTimeIntervalSince1970 + CFTimeZoneGetSecondsFromGMT(cfTimeZone, timeInterval);
+            infos[index] = INWeekInformationFromDays((NSInteger)INDateFloorDivide(localSeconds, INDateSecondsPerDay), rule);
+        }
+    });
+}
+
+
+// the numbers 00..99 as pairs of characters
+static const char INDurationDigitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+size_t INDurationFormatUTF8(NSTimeInterval seconds, INDurationFormatOptions options, NSUInteger fractionDigits, char *buffer, size_t bufferSize) {
+    BOOL printSeconds = (options & INDurationFormatPrintSeconds) != 0;
+    fractionDigits = printSeconds ? MIN(fractionDigits, (NSUInteger)6) : 0;
+    int64_t scale = 1;
+    for (NSUInteger index = 0; index < fractionDigits; index++) {
+        scale *= 10;
+    }
+    // truncate the absolute value, so negative durations are written the same as positive ones
+    NSTimeInterval absoluteUnits = floor(fabs(seconds) * scale);
+    if (!(absoluteUnits < 9e18)) {
+        return 0;
+    }
+    int64_t units = (int64_t)absoluteUnits;
+    int64_t wholeSeconds = units / scale;
+    int64_t hours = wholeSeconds / 3600;
+    if ((options & INDurationFormatWrapHours) != 0) {
+        hours %= 24;
+    }
+    NSInteger minutes = (NSInteger)(wholeSeconds / 60 % 60);
+
+    // write the hours backwards into a temporary buffer, they may have any number of digits
+    char hourDigits[20];
+    size_t hourLength = 0;
+    do {
+        hourLength += 2;
+        memcpy(hourDigits + sizeof(hourDigits) - hourLength, INDurationDigitPairs + hours % 100 * 2, 2);
+        hours /= 100;
+    } while (hours > 0);
+    if (hourLength > 2 && hourDigits[sizeof(hourDigits) - hourLength] == '0') {
+        hourLength--;
+    }
+
+    BOOL printSign = (options & INDurationFormatPrintSign) != 0;
+    size_t length = (printSign ? 1 : 0) + hourLength + 3 + (printSeconds ? 3 : 0) + (fractionDigits > 0 ? fractionDigits + 1 : 0);
+    if (bufferSize < length + 1) {
+        return 0;
+    }
+
+    char *cursor = buffer;
+    if (printSign) {
+        *cursor++ = seconds < 0 ? '-' : '+';
+    }
+    memcpy(cursor, hourDigits + sizeof(hourDigits) - hourLength, hourLength);
+    cursor += hourLength;
+    *cursor++ = ':';
+    memcpy(cursor, INDurationDigitPairs + minutes * 2, 2);
+    cursor += 2;
+    if (printSeconds) {
+        *cursor++ = ':';
+        memcpy(cursor, INDurationDigitPairs + wholeSeconds % 60 * 2, 2);
+        cursor += 2;
+    }
+    if (fractionDigits > 0) {
+        *cursor++ = '.';
+        int64_t fraction = units % scale;
+        for (NSUInteger index = fractionDigits; index > 0; index--) {
+            cursor[index - 1] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+        cursor += fractionDigits;
+    }
+    *cursor = '\0';
+    return length;
+}
+
+NSString *INDurationStringFromSeconds(NSTimeInterval seconds, INDurationFormatOptions options, NSUInteger fractionDigits) {
+    char buffer[INDurationMaximumLength + 1];
+    size_t length = INDurationFormatUTF8(seconds, options, fractionDigits, buffer, sizeof(buffer));
+    if (length == 0) {
+        return nil;
+    }
+    return (__bridge_transfer NSString *)CFStringCreateWithBytes(kCFAllocatorDefault, (const UInt8 *)buffer, (CFIndex)length, kCFStringEncodingASCII, false);
+}
+
+NSArray *INDurationStringsFromSeconds(const NSTimeInterval *seconds, size_t count, INDurationFormatOptions options, NSUInteger fractionDigits) {
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+    char buffer[INDurationMaximumLength + 1];
+    for (size_t index = 0; index < count; index++) {
+        size_t length = INDurationFormatUTF8(seconds[index], options, fractionDigits, buffer, sizeof(buffer));
+        NSString *string = (__bridge_transfer NSString *)CFStringCreateWithBytes(kCFAllocatorDefault, (const UInt8 *)buffer, (CFIndex)length, kCFStringEncodingASCII, false);
+        [strings addObject:string];
+    }
+    return strings;
+}
+
+// Calls the block for each step of the range until the end date is exceeded or the block stops.
+static inline void INDateRangeEnumerate(INPackedDate startDate, INPackedDate endDate, INDateRangeUnit unit, void (^block)(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop)) {
+    BOOL stop = NO;
+    for (NSInteger index = 0; !stop; index++) {
+        INPackedDate date = INDateRangeDateAtIndex(startDate, unit, index);
+        if (date > endDate) {
+            break;
+        }
+        block(date, INDateInformationFromPackedDate(date), &stop);
+    }
+}
+
 
 @implementation NSDate (IExtensions)
 
@@ -67,7 +595,27 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 + (void)setCachedGregorianCalendar:(NSCalendar *)calendar {
+    // make sure the default calendar is not set afterwards
+    [self cachedGregorianCalendar];
+    atomic_store_explicit(&__cachedCalendarIsGregorian, [calendar.calendarIdentifier isEqualToString:NSCalendarIdentifierGregorian], memory_order_release);
     __defaultCachedGregorianCalendar = calendar;
+    atomic_fetch_add(&__cachedCalendarGeneration, 1);
+    INDateInvalidateToday();
+}
+
++ (NSCalendar *)threadGregorianCalendar {
+    NSCalendar *cachedCalendar = [self cachedGregorianCalendar];
+    if (cachedCalendar == nil) {
+        return nil;
+    }
+    NSUInteger generation = atomic_load(&__cachedCalendarGeneration);
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    INThreadCalendar *threadCalendar = threadDictionary[INThreadCalendarKey];
+    if (![threadCalendar isCopyOfCalendar:cachedCalendar generation:generation]) {
+        threadCalendar = [[INThreadCalendar alloc] initWithCalendar:cachedCalendar generation:generation];
+        threadDictionary[INThreadCalendarKey] = threadCalendar;
+    }
+    return threadCalendar.calendar;
 }
 
 + (NSInteger)secondsForDays:(NSInteger)days hours:(NSInteger)hours minutes:(NSInteger)minutes seconds:(NSInteger)seconds {
@@ -79,38 +627,36 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 + (NSString *)stringRepresentationForSeconds:(NSInteger)seconds printSign:(BOOL)printSign printSeconds:(BOOL)printSeconds {
-	NSInteger hour = (seconds / 3600) % 24;
-	NSInteger rest = seconds % 3600;
-	NSInteger min = rest / 60;
-	NSInteger secs = rest % 60;
-	NSString *prefix = @"";
-    if (printSign && seconds >= 0) {
-        prefix = @"+";
-    } else if (printSign && seconds < 0) {
-        prefix = @"-";
-    }
-	NSString *time = nil;
-	if (printSeconds) {
-		time = [NSString stringWithFormat:@"%@%.2ld:%.2ld:%.2ld", prefix, labs(hour), labs(min), labs(secs)];
-	} else {
-		time = [NSString stringWithFormat:@"%@%.2ld:%.2ld", prefix, labs(hour), labs(min)];
-	}
-	return time;
+    INDurationFormatOptions options = INDurationFormatWrapHours;
+    if (printSign) {
+        options |= INDurationFormatPrintSign;
+    }
+    if (printSeconds) {
+        options |= INDurationFormatPrintSeconds;
+    }
+    return INDurationStringFromSeconds(seconds, options, 0);
 }
 
 - (BOOL)isToday {
+    NSTimeInterval start, end;
+    if (INArithmeticToday(&start, &end)) {
+        NSTimeInterval timeInterval = [self timeIntervalSinceReferenceDate];
+        return timeInterval >= start && timeInterval < end;
+    }
     return [self isSameDay:[NSDate date]];
 }
 
 - (BOOL)isSameDay:(NSDate *)otherDate {
-    NSDateComponents *comp1;
-    NSDateComponents *comp2;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        NSUInteger components = NSCalendarUnitYear | NSCalendarUnitMonth |  NSCalendarUnitDay;
-        comp1 = [gregorian components:components fromDate:self];
-        comp2 = [gregorian components:components fromDate:otherDate];
+    // only the local days have to be compared, no need for the date's fields
+    NSInteger days, otherDays, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay) && INArithmeticLocalDays(otherDate, &otherDays, &secondsOfDay)) {
+        return days == otherDays;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSUInteger components = NSCalendarUnitYear | NSCalendarUnitMonth |  NSCalendarUnitDay;
+    NSDateComponents *comp1 = [gregorian components:components fromDate:self];
+    NSDateComponents *comp2 = [gregorian components:components fromDate:otherDate];
     // isToday if day, month and year are equal
     return [comp1 day] == [comp2 day] && [comp1 month] == [comp2 month] && [comp1 year] == [comp2 year];
 } 
@@ -123,20 +669,36 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 
 - (INDateInformation)dateInformationForComponents:(NSCalendarUnit)components {
     INDateInformation info;
-    
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        NSDateComponents *comp = [gregorian components:components fromDate:self];
-        
-        info.year = [comp year];
-        info.month = [comp month];
-        info.day = [comp day];
-        info.weekday = [comp weekday];
-        info.hour = [comp hour];
-        info.minute = [comp minute];
-        info.second = [comp second];
+    if (INArithmeticDateInformation(self, &info)) {
+        // the fields not asked for are undefined like in NSDateComponents
+        if ((components & NSCalendarUnitYear) == 0) info.year = NSDateComponentUndefined;
+        if ((components & NSCalendarUnitMonth) == 0) info.month = NSDateComponentUndefined;
+        if ((components & NSCalendarUnitDay) == 0) info.day = NSDateComponentUndefined;
+        if ((components & NSCalendarUnitWeekday) == 0) info.weekday = NSDateComponentUndefined;
+        if ((components & NSCalendarUnitHour) == 0) info.hour = NSDateComponentUndefined;
+        if ((components & NSCalendarUnitMinute) == 0) info.minute = NSDateComponentUndefined;
+        if ((components & NSCalendarUnitSecond) == 0) info.second = NSDateComponentUndefined;
+        return info;
     }
     
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comp = [gregorian components:components fromDate:self];
+    
+    info.year = [comp year];
+    info.month = [comp month];
+    info.day = [comp day];
+    info.weekday = [comp weekday];
+    info.hour = [comp hour];
+    info.minute = [comp minute];
+    info.second = [comp second];
+    
+    return info;
+}
+
+- (INDateInformation)dateInformationWithTimeZoneTable:(INTimeZoneTable *)timeZoneTable {
+    INDateInformation info;
+    NSTimeInterval timeInterval = [self timeIntervalSinceReferenceDate];
+    INDateInformationFillFromTimeIntervalsWithTimeZoneTable(&timeInterval, &info, 1, timeZoneTable);
     return info;
 }
 
@@ -150,13 +712,17 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
     [comps setSecond:dateInfo.second];
     [comps setTimeZone:timeZone];
 
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    NSDate *date;
-    @synchronized(gregorian) {
-        date = [gregorian dateFromComponents:comps];
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    return [gregorian dateFromComponents:comps];
+}
+
++ (NSDate *)dateWithDateInformation:(INDateInformation)dateInfo timeZoneTable:(INTimeZoneTable *)timeZoneTable {
+    int64_t localSeconds = INDateSecondsFromCivil(dateInfo.year, dateInfo.month, dateInfo.day, dateInfo.hour, dateInfo.minute, dateInfo.second);
+    NSTimeInterval localTimeInterval = localSeconds - NSTimeIntervalSince1970;
+    if (!INDateArithmeticSupportsTimeInterval(localTimeInterval)) {
+        return [self dateWithDateInformation:dateInfo timeZone:timeZoneTable.timeZone];
     }
-    
-    return date;
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:[timeZoneTable timeIntervalForLocalTimeInterval:localTimeInterval]];
 }
 
 + (NSDate *)dateWithDateInformation:(INDateInformation)dateInfo {
@@ -168,16 +734,46 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
     [comps setMinute:dateInfo.minute];
     [comps setSecond:dateInfo.second];
 	
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    NSDate *date;
-    @synchronized(gregorian) {
-        date = [gregorian dateFromComponents:comps];
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    return [gregorian dateFromComponents:comps];
+}
+
+- (INPackedDate)packedDate {
+    return [self packedDateWithTimeZone:nil];
+}
+
+- (INPackedDate)packedDateWithTimeZone:(NSTimeZone *)timeZone {
+    if (timeZone == nil) {
+        timeZone = [[NSDate cachedGregorianCalendar] timeZone];
     }
-    
-    return date;
+    NSTimeInterval timeInterval = [self timeIntervalSinceReferenceDate];
+    int64_t localSeconds = (int64_t)floor(timeInterval) + (int64_t)NSTimeIntervalSince1970 + CFTimeZoneGetSecondsFromGMT((__bridge CFTimeZoneRef)timeZone, timeInterval);
+    int64_t days = INDateFloorDivide(localSeconds, INDateSecondsPerDay);
+    return INPackedDateMakeWithDays((NSInteger)days, (NSInteger)(localSeconds - days * INDateSecondsPerDay));
+}
+
++ (NSDate *)dateWithPackedDate:(INPackedDate)packedDate {
+    return [self dateWithPackedDate:packedDate timeZone:nil];
+}
+
++ (NSDate *)dateWithPackedDate:(INPackedDate)packedDate timeZone:(NSTimeZone *)timeZone {
+    if (timeZone == nil) {
+        timeZone = [[NSDate cachedGregorianCalendar] timeZone];
+    }
+    NSTimeInterval localTimeInterval = (NSTimeInterval)INPackedDateGetDays(packedDate) * INDateSecondsPerDay + INPackedDateGetSecondsOfDay(packedDate) - NSTimeIntervalSince1970;
+    NSTimeInterval timeInterval = INDateTimeIntervalFromLocalTimeInterval(localTimeInterval, INDateTimeZoneOffsetFunction, (__bridge CFTimeZoneRef)timeZone);
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval];
 }
 
 - (NSDate *)dateWithFirstOfMonth {
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        NSDate *date = INArithmeticDateFromLocalDays(INDateFirstOfMonthFromDays(days), 0);
+        if (date != nil) {
+            return date;
+        }
+    }
+
 	INDateInformation info = [self dateInformation];
 	info.day = 1;
 	info.minute = 0;
@@ -187,6 +783,14 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 - (NSDate *)dateWithLastOfMonth {
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        NSDate *date = INArithmeticDateFromLocalDays(INDateLastOfMonthFromDays(days), 0);
+        if (date != nil) {
+            return date;
+        }
+    }
+
 	INDateInformation info = [self dateInformation];
     NSDate *temp;
     for (NSInteger i = 0; i < 4; i++) {
@@ -203,6 +807,17 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 - (NSDate *)dateWithNextMonth {
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        // a day not existing in the new month results in the month's last day with the time zeroed
+        BOOL clamped;
+        NSInteger newDays = INDateDaysByAddingMonths(days, 1, &clamped);
+        NSDate *date = INArithmeticDateFromLocalDays(newDays, clamped ? 0 : secondsOfDay);
+        if (date != nil) {
+            return date;
+        }
+    }
+
 	INDateInformation info = [self dateInformation];
 	info.month++;
 	if (info.month > 12) {
@@ -218,6 +833,17 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 - (NSDate *)dateWithPrevMonth {
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        // a day not existing in the new month results in the month's last day with the time zeroed
+        BOOL clamped;
+        NSInteger newDays = INDateDaysByAddingMonths(days, -1, &clamped);
+        NSDate *date = INArithmeticDateFromLocalDays(newDays, clamped ? 0 : secondsOfDay);
+        if (date != nil) {
+            return date;
+        }
+    }
+
 	INDateInformation info = [self dateInformation];
 	info.month--;
 	if (info.month < 1) {
@@ -233,6 +859,14 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 - (NSDate *)dateWithFirstOfYear {
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        NSDate *date = INArithmeticDateFromLocalDays(INDateFirstOfYearFromDays(days), 0);
+        if (date != nil) {
+            return date;
+        }
+    }
+
     INDateInformation info = [self dateInformation];
     info.month = 1;
     info.day = 1;
@@ -243,6 +877,16 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 - (NSDate *)dateWithWeekstart:(NSInteger)daynumber {
+    NSInteger days, secondsOfDay;
+    if (daynumber >= 1 && daynumber <= 7 && INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        // keep the fractions of the second like adding days with NSCalendar does
+        NSTimeInterval timeInterval = [self timeIntervalSinceReferenceDate];
+        NSDate *date = INArithmeticDateFromLocalDays(INDateWeekstartFromDays(days, daynumber), secondsOfDay + timeInterval - floor(timeInterval));
+        if (date != nil) {
+            return date;
+        }
+    }
+
     INDateInformation dateInfo = [self dateInformation];
     NSInteger daysToSub = (dateInfo.weekday - daynumber + 7) % 7;
     NSDate *date = [self dateWithDaysAdded:-daysToSub];
@@ -251,143 +895,177 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 
 
 - (NSInteger)yearNumber {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitYear fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.year;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitYear fromDate:self];
     return comps.year;
 }
 
 - (NSInteger)monthNumber {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitMonth fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.month;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitMonth fromDate:self];
     return comps.month;
 }
 
 - (NSInteger)quarterNumber {
     return ([self monthNumber] - 1) / 3 + 1;
 /*  // *Workaround* The code should be the following, but it seems there is a bug in iOS, so we calculate the quarter from the month instead.
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitQuarter fromDate:self];
-    }
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitQuarter fromDate:self];
     return comps.quarter;
 */
 }
 
 - (NSInteger)weekNumberOfYear {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitWeekOfYear fromDate:self];
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        return INWeekRuleWeekOfYearFromDays(days, INCachedCalendarWeekRule(), NULL);
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitWeekOfYear fromDate:self];
     return comps.weekOfYear;
 }
 
 - (NSInteger)weekNumberOfMonth {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitWeekOfMonth fromDate:self];
+    NSInteger days, secondsOfDay;
+    if (INArithmeticLocalDays(self, &days, &secondsOfDay)) {
+        return INWeekRuleWeekOfMonthFromDays(days, INCachedCalendarWeekRule());
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitWeekOfMonth fromDate:self];
     return comps.weekOfMonth;
 }
 
+- (NSInteger)weekNumberOfYearWithRule:(INWeekRule)rule {
+    return INWeekRuleWeekOfYearFromDays(INPackedDateGetDays([self packedDate]), rule, NULL);
+}
+
+- (NSInteger)weekYearWithRule:(INWeekRule)rule {
+    NSInteger weekYear;
+    INWeekRuleWeekOfYearFromDays(INPackedDateGetDays([self packedDate]), rule, &weekYear);
+    return weekYear;
+}
+
+- (NSInteger)weekNumberOfMonthWithRule:(INWeekRule)rule {
+    return INWeekRuleWeekOfMonthFromDays(INPackedDateGetDays([self packedDate]), rule);
+}
+
 - (NSInteger)dayNumberOfMonth {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitDay fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.day;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitDay fromDate:self];
     return comps.day;
 }
 
 - (NSInteger)dayNumberOfYear {
-    NSInteger dayOfYear;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        dayOfYear = [gregorian ordinalityOfUnit:NSCalendarUnitDay inUnit:NSCalendarUnitYear forDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return INDateDayOfYearFromDays(INDateDaysFromCivil(info.year, info.month, info.day), info.year);
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSInteger dayOfYear = [gregorian ordinalityOfUnit:NSCalendarUnitDay inUnit:NSCalendarUnitYear forDate:self];
     return dayOfYear;
 }
 
 - (NSInteger)dayNumberOfWeekInMonth {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitWeekdayOrdinal fromDate:self];
-    }
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitWeekdayOrdinal fromDate:self];
     return comps.weekdayOrdinal;
 }
 
 - (NSInteger)weekdayNumber {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitWeekday fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.weekday;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitWeekday fromDate:self];
     return comps.weekday;
 }
 
 - (NSInteger)hourNumber {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitHour fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.hour;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitHour fromDate:self];
     return comps.hour;
 }
 
 - (NSInteger)minuteNumber {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitMinute fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.minute;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitMinute fromDate:self];
     return comps.minute;
 }
 
 - (NSInteger)secondNumber {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitSecond fromDate:self];
+    INDateInformation info;
+    if (INArithmeticDateInformation(self, &info)) {
+        return info.second;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitSecond fromDate:self];
     return comps.second;
 }
 
 
 - (NSInteger)yearsBetweenDate:(NSDate *)otherDate {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitYear fromDate:self toDate:otherDate options:0];
+    NSInteger difference;
+    if (INArithmeticDateDifference(self, otherDate, NSCalendarUnitYear, &difference)) {
+        return difference;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitYear fromDate:self toDate:otherDate options:0];
     
     return [comps year];
 }
 
 - (NSInteger)monthsBetweenDate:(NSDate *)otherDate {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitMonth fromDate:self toDate:otherDate options:0];
+    NSInteger difference;
+    if (INArithmeticDateDifference(self, otherDate, NSCalendarUnitMonth, &difference)) {
+        return difference;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitMonth fromDate:self toDate:otherDate options:0];
     
     return [comps month];
 }
 
 - (NSInteger)daysBetweenDate:(NSDate *)otherDate {
-    NSDateComponents *comps;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        comps = [gregorian components:NSCalendarUnitDay fromDate:self toDate:otherDate options:0];
+    NSInteger difference;
+    if (INArithmeticDateDifference(self, otherDate, NSCalendarUnitDay, &difference)) {
+        return difference;
     }
+
+    NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+    NSDateComponents *comps = [gregorian components:NSCalendarUnitDay fromDate:self toDate:otherDate options:0];
     
     return [comps day];
 }
@@ -415,33 +1093,24 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 - (NSDate *)dateWithDaysAdded:(NSInteger)days {
 	NSDateComponents *components = [[NSDateComponents alloc] init];
 	[components setDay:days];
-	NSDate *newDate;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        newDate = [gregorian dateByAddingComponents:components toDate:self options:0];
-    }
+	NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+	NSDate *newDate = [gregorian dateByAddingComponents:components toDate:self options:0];
 	return newDate;
 }
 
 - (NSDate *)dateWithMonthsAdded:(NSInteger)months {
 	NSDateComponents *components = [[NSDateComponents alloc] init];
 	[components setMonth:months];
-	NSDate *newDate;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        newDate = [gregorian dateByAddingComponents:components toDate:self options:0];
-    }
+	NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+	NSDate *newDate = [gregorian dateByAddingComponents:components toDate:self options:0];
 	return newDate;
 }
 
 - (NSDate *)dateWithYearsAdded:(NSInteger)years {
 	NSDateComponents *components = [[NSDateComponents alloc] init];
 	[components setYear:years];
-	NSDate *newDate;
-    NSCalendar *gregorian = [NSDate cachedGregorianCalendar];
-    @synchronized(gregorian) {
-        newDate = [gregorian dateByAddingComponents:components toDate:self options:0];
-    }
+	NSCalendar *gregorian = [NSDate threadGregorianCalendar];
+	NSDate *newDate = [gregorian dateByAddingComponents:components toDate:self options:0];
 	return newDate;
 }
 
@@ -455,4 +1124,64 @@ static NSCalendar *__defaultCachedGregorianCalendar = nil;
 }
 
 
+- (void)enumerateDatesUntilDate:(NSDate *)endDate unit:(INDateRangeUnit)unit usingBlock:(void (^)(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop))block {
+    INDateRangeEnumerate([self packedDate], [endDate packedDate], unit, block);
+}
+
+- (INDateRange *)dateRangeUntilDate:(NSDate *)endDate unit:(INDateRangeUnit)unit {
+    return [INDateRange rangeWithStartDate:[self packedDate] endDate:[endDate packedDate] unit:unit];
+}
+
+
+@end
+
+
+
+// number of NSNumber objects held by a date range during fast enumeration
+#define INDateRangeBufferSize 16
+
+@implementation INDateRange {
+    // keeps the numbers returned by the last fast enumeration call alive
+    __strong NSNumber *_buffer[INDateRangeBufferSize];
+}
+
++ (instancetype)rangeWithStartDate:(INPackedDate)startDate endDate:(INPackedDate)endDate unit:(INDateRangeUnit)unit {
+    return [[self alloc] initWithStartDate:startDate endDate:endDate unit:unit];
+}
+
+- (instancetype)initWithStartDate:(INPackedDate)startDate endDate:(INPackedDate)endDate unit:(INDateRangeUnit)unit {
+    self = [super init];
+    if (self == nil) return self;
+
+    _startDate = startDate;
+    _endDate = endDate;
+    _unit = unit;
+
+    return self;
+}
+
+- (void)enumerateDatesUsingBlock:(void (^)(INPackedDate packedDate, INDateInformation dateInfo, BOOL *stop))block {
+    INDateRangeEnumerate(_startDate, _endDate, _unit, block);
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len {
+    // state holds the index of the next step, the range is immutable so there are no mutations to track
+    if (state->state == 0) {
+        state->mutationsPtr = &state->extra[0];
+    }
+    NSUInteger count = 0;
+    while (count < MIN(len, INDateRangeBufferSize)) {
+        INPackedDate date = INDateRangeDateAtIndex(_startDate, _unit, (NSInteger)state->state);
+        if (date > _endDate) {
+            break;
+        }
+        _buffer[count] = @(date);
+        count++;
+        state->state++;
+    }
+    state->itemsPtr = (__unsafe_unretained id *)(void *)_buffer;
+    return count;
+}
+
+
 @end
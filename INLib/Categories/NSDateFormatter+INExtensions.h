@@ -20,6 +20,89 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#import "NSDate+INExtensions.h"
+
+
+@class INDatePattern;
+
+
+/**
+ The maximum length of a string written by INISO8601FormatUTF8() without the terminating null character.
+ */
+static const size_t INISO8601MaximumLength = 32;
+
+
+/**
+ Parses an ISO 8601 or RFC 3339 date string from a UTF-8 buffer without NSDateFormatter and without allocating any objects.
+ 
+ Supported are the extended forms with a date only or a date and time, seconds and fractions of seconds are optional.
+ The time may be separated by 'T' or a space and may be followed by 'Z' or an offset in the forms ±hh:mm, ±hhmm or ±hh.
+ Strings without an offset are interpreted as GMT.
+ 
+    2016-02-29
+    2016-02-29T13:45Z
+    2016-02-29T13:45:10.125+01:00
+ 
+ @param string The buffer with the characters, doesn't need to be null terminated.
+ @param length The number of characters in the buffer to parse, the whole length has to be a valid date.
+ @param timeInterval On return the seconds since the reference date 1st January 2001 GMT, may be NULL.
+ @param dateInfo On return the date and time as written in the string in its offset, may be NULL.
+ @return True if the string is a valid date, otherwise false and the output parameters are not changed.
+ */
+BOOL INISO8601ParseUTF8(const char *string, size_t length, NSTimeInterval *timeInterval, INDateInformation *dateInfo);
+
+
+/**
+ Parses an ISO 8601 or RFC 3339 date string without NSDateFormatter.
+ 
+ The same as INISO8601ParseUTF8(), the characters are read without creating any objects.
+ 
+    NSTimeInterval timeInterval;
+    if (INISO8601ParseString(@"2016-02-29T13:45:10Z", &timeInterval, NULL)) {
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval];
+    }
+ 
+ @param string The string to parse.
+ @param timeInterval On return the seconds since the reference date 1st January 2001 GMT, may be NULL.
+ @param dateInfo On return the date and time as written in the string in its offset, may be NULL.
+ @return True if the string is a valid date, otherwise false.
+ */
+BOOL INISO8601ParseString(NSString *string, NSTimeInterval *timeInterval, INDateInformation *dateInfo);
+
+
+/**
+ Formats a point in time as an ISO 8601 and RFC 3339 string into a UTF-8 buffer without NSDateFormatter.
+ 
+ The format is `yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ` with the given number of fraction digits, which are truncated the same way as NSDateFormatter does.
+ A zero offset is written as 'Z', any other offset as ±hh:mm.
+ 
+    char buffer[INISO8601MaximumLength + 1];
+    size_t length = INISO8601FormatUTF8(0, 3600, 3, buffer, sizeof(buffer));
+    // buffer: 2001-01-01T01:00:00.000+01:00
+ 
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @param secondsFromGMT The offset to write the date in, only full minutes are used.
+ @param fractionDigits The number of digits for the fractions of seconds, 0..6.
+ @param buffer The buffer to write the null terminated string into.
+ @param bufferSize The size of the buffer, INISO8601MaximumLength + 1 is always enough.
+ @return The length of the written string or 0 if the buffer is too small or the year is not within 0..9999.
+ */
+size_t INISO8601FormatUTF8(NSTimeInterval timeInterval, NSInteger secondsFromGMT, NSUInteger fractionDigits, char *buffer, size_t bufferSize);
+
+
+/**
+ Formats a point in time as an ISO 8601 and RFC 3339 string without NSDateFormatter.
+ 
+ The same as INISO8601FormatUTF8(), but returns a new string.
+ 
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @param secondsFromGMT The offset to write the date in, only full minutes are used.
+ @param fractionDigits The number of digits for the fractions of seconds, 0..6.
+ @return The formatted string or nil if the year is not within 0..9999.
+ */
+NSString *INISO8601StringFromTimeInterval(NSTimeInterval timeInterval, NSInteger secondsFromGMT, NSUInteger fractionDigits);
+
+
 
 @interface NSDateFormatter (INExtensions)
 
@@ -31,20 +114,230 @@
  
  If there is no date formatter for the given format a new formatter will be created.
  Creating a new NSDateFormatter is time expensive so use this method for reusing old formatters.
- When using background threads the date formatter should be locked with a synchronized command.
+ Each thread gets its own formatters, so the returned formatter can be used on the calling thread without any lock, but must not be passed to other threads.
+ The formatter uses the current locale and the default time zone, when one of them changes a new formatter will be created.
  
-    NSString *string;
     NSDateFormatter *dateFormatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy"];
-    @synchronized(dateFormatter) {
-        string = [dateFormatter stringFromDate:self];
-    }
+    NSString *string = [dateFormatter stringFromDate:self];
 
  For information about the date format pattern see:
  http://unicode.org/reports/tr35/tr35-10.html#Date_Format_Patterns
  
+ @param format The date format of the formatter.
  @return A cached date formatter for the given format.
+ @see cachedDateFormatterForFormat:locale:timeZone:
  */
 + (NSDateFormatter *)cachedDateFormatterForFormat:(NSString *)format;
 
 
+/**
+ Returns a cached date formatter object for the given format string, locale and time zone.
+ 
+ The formatters are cached for each thread without any lock, see cachedDateFormatterForFormat:.
+ Each thread holds only a limited number of formatters, the least recently used one will be removed when the limit is reached.
+ All cached formatters will be removed when the system's locale or time zone change and on memory warnings.
+ Never change any properties of the returned formatter, otherwise it will be returned changed for the next request, too.
+ 
+    NSLocale *locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    NSDateFormatter *dateFormatter = [NSDateFormatter cachedDateFormatterForFormat:@"yyyy-MM-dd'T'HH:mm:ss" locale:locale timeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
+ 
+ @param format The date format of the formatter.
+ @param locale The locale of the formatter, nil for the current locale.
+ @param timeZone The time zone of the formatter, nil for the default time zone.
+ @return A cached date formatter for the given format, locale and time zone.
+ */
++ (NSDateFormatter *)cachedDateFormatterForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone;
+
+
+/**
+ Returns a cached date pattern for the given format string, locale and time zone.
+ 
+ The patterns share the cache of cachedDateFormatterForFormat:locale:timeZone:, so a pattern and a formatter for the same values are stored in the same entry.
+ Returns nil when the format contains fields which are not supported by INDatePattern, use the cached date formatter instead in that case.
+ 
+    INDatePattern *pattern = [NSDateFormatter cachedDatePatternForFormat:@"dd.MM.yyyy HH:mm" locale:nil timeZone:nil];
+    NSString *string = [pattern stringFromTimeInterval:[date timeIntervalSinceReferenceDate]];
+ 
+ @param format The date format of the pattern.
+ @param locale The locale of the pattern, nil for the current locale.
+ @param timeZone The time zone of the pattern, nil for the default time zone.
+ @return A cached date pattern or nil if the format is not supported.
+ */
++ (INDatePattern *)cachedDatePatternForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone;
+
+
+#pragma mark - Parsing in bulk
+/// @name Parsing in bulk
+
+/**
+ Parses an array of date strings into time intervals.
+ 
+ Large arrays are split into chunks, which are parsed concurrently on all cores, each worker with its own cached formatter.
+ The results are the same as parsing each string with dateFromString: of the formatter from cachedDateFormatterForFormat:locale:timeZone:.
+ Invalid strings and objects which aren't strings get NAN as time interval and their indexes are returned.
+ 
+    NSTimeInterval *timeIntervals = malloc(strings.count * sizeof(NSTimeInterval));
+    NSIndexSet *invalidIndexes = [NSDateFormatter parseDateStrings:strings withFormat:@"dd.MM.yyyy HH:mm" locale:nil timeZone:nil intoTimeIntervals:timeIntervals];
+ 
+ @param strings The strings to parse.
+ @param format The date format of the strings.
+ @param locale The locale of the formatters, nil for the current locale.
+ @param timeZone The time zone of the formatters, nil for the default time zone.
+ @param timeIntervals A buffer for strings.count time intervals, which get the seconds since the reference date 1st January 2001 GMT.
+ @return The indexes of all strings which couldn't be parsed.
+ */
++ (NSIndexSet *)parseDateStrings:(NSArray *)strings withFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone intoTimeIntervals:(NSTimeInterval *)timeIntervals;
+
+
+/**
+ Parses a C array of null terminated UTF-8 date strings into time intervals.
+ 
+ The same as parseDateStrings:withFormat:locale:timeZone:intoTimeIntervals:, but the strings are read without copying them.
+ NULL pointers and strings which aren't valid UTF-8 are invalid.
+ 
+ @param strings The strings to parse.
+ @param count The number of strings.
+ @param format The date format of the strings.
+ @param locale The locale of the formatters, nil for the current locale.
+ @param timeZone The time zone of the formatters, nil for the default time zone.
+ @param timeIntervals A buffer for count time intervals, which get the seconds since the reference date 1st January 2001 GMT.
+ @return The indexes of all strings which couldn't be parsed.
+ */
++ (NSIndexSet *)parseUTF8DateStrings:(const char * const *)strings count:(NSUInteger)count withFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone intoTimeIntervals:(NSTimeInterval *)timeIntervals;
+
+@end
+
+
+
+/**
+ A date format compiled into a list of operations, which formats dates without NSDate and NSDateFormatter.
+ 
+ The format is parsed once into numeric fields, name fields and literals, the names of months, weekdays and the AM/PM symbols are taken once for each locale from NSDateFormatter.
+ Formatting writes directly into a buffer without allocating any objects and is safe to call from any thread.
+ 
+ Supported fields are y, yy, M..MMMMM, L..LLLLL, d, D, E..EEEEE, a, H, k, h, K, m, s, S (any count), Z..ZZZ and ZZZZZ.
+ Any other letter makes the format unsupported, other characters and quoted text are written as they are.
+ Dates are calculated with the proleptic gregorian calendar, so the results equal NSDateFormatter's results for all days from the 15th October 1582 on.
+ 
+    INDatePattern *pattern = [INDatePattern patternWithFormat:@"EEEE, d. MMMM yyyy" locale:[NSLocale localeWithLocaleIdentifier:@"de_DE"] timeZone:nil];
+    char buffer[64];
+    [pattern formatDateInformation:INDateInformationMake(2016, 2, 29, 0, 0, 0) intoBuffer:buffer size:sizeof(buffer)];
+    // buffer: Montag, 29. Februar 2016
+ */
+@interface INDatePattern : NSObject
+
+/**
+ The date format of the pattern.
+ */
+@property (nonatomic, copy, readonly) NSString *format;
+
+/**
+ The locale the names are taken from.
+ */
+@property (nonatomic, strong, readonly) NSLocale *locale;
+
+/**
+ The time zone time intervals are formatted in.
+ */
+@property (nonatomic, strong, readonly) NSTimeZone *timeZone;
+
+
+/**
+ Compiles a date pattern.
+ 
+ Use NSDateFormatter's cachedDatePatternForFormat:locale:timeZone: to reuse compiled patterns.
+ 
+ @param format The date format in the same syntax as NSDateFormatter's dateFormat.
+ @param locale The locale for names of months and weekdays, nil for the current locale.
+ @param timeZone The time zone for formatting time intervals, nil for the default time zone.
+ @return The new pattern or nil if the format contains unsupported fields.
+ */
++ (instancetype)patternWithFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone;
+
+
+/**
+ Compiles a date pattern.
+ 
+ @param format The date format in the same syntax as NSDateFormatter's dateFormat.
+ @param locale The locale for names of months and weekdays, nil for the current locale.
+ @param timeZone The time zone for formatting time intervals, nil for the default time zone.
+ @return The initialized pattern or nil if the format contains unsupported fields.
+ */
+- (instancetype)initWithFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone;
+
+
+#pragma mark - Formatting into buffers
+/// @name Formatting into buffers
+
+/**
+ Formats a date and time into a UTF-8 buffer.
+ 
+ Works like snprintf, the string is cut when the buffer is too small but always null terminated.
+ The weekday is calculated from the date, the date information's weekday field is ignored.
+ Fractions of seconds are written as zeros and time zone fields use the pattern time zone's offset at that local time.
+ 
+ @param dateInfo The date and time to format.
+ @param buffer The buffer to write into.
+ @param bufferSize The size of the buffer.
+ @return The length of the whole string without the null character, which may be more than has been written.
+ */
+- (size_t)formatDateInformation:(INDateInformation)dateInfo intoBuffer:(char *)buffer size:(size_t)bufferSize;
+
+
+/**
+ Formats a point in time in the pattern's time zone into a UTF-8 buffer.
+ 
+ Works like snprintf, the string is cut when the buffer is too small but always null terminated.
+ 
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @param buffer The buffer to write into.
+ @param bufferSize The size of the buffer.
+ @return The length of the whole string without the null character, which may be more than has been written.
+ */
+- (size_t)formatTimeInterval:(NSTimeInterval)timeInterval intoBuffer:(char *)buffer size:(size_t)bufferSize;
+
+
+#pragma mark - Formatting into strings
+/// @name Formatting into strings
+
+/**
+ Appends a formatted date and time to a string.
+ 
+ @see formatDateInformation:intoBuffer:size:
+ @param dateInfo The date and time to format.
+ @param string The string to append to.
+ */
+- (void)appendDateInformation:(INDateInformation)dateInfo toString:(NSMutableString *)string;
+
+
+/**
+ Appends a point in time formatted in the pattern's time zone to a string.
+ 
+ @see formatTimeInterval:intoBuffer:size:
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @param string The string to append to.
+ */
+- (void)appendTimeInterval:(NSTimeInterval)timeInterval toString:(NSMutableString *)string;
+
+
+/**
+ Returns a formatted date and time.
+ 
+ @see formatDateInformation:intoBuffer:size:
+ @param dateInfo The date and time to format.
+ @return The new string.
+ */
+- (NSString *)stringFromDateInformation:(INDateInformation)dateInfo;
+
+
+/**
+ Returns a point in time formatted in the pattern's time zone.
+ 
+ @see formatTimeInterval:intoBuffer:size:
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @return The new string.
+ */
+- (NSString *)stringFromTimeInterval:(NSTimeInterval)timeInterval;
+
+
 @end
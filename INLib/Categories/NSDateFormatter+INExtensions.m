@@ -22,37 +22,943 @@
 
 
 #import "NSDateFormatter+INExtensions.h"
+#import "INDateArithmetic.h"
+#import "INConcurrentChunks.h"
+#import <stdatomic.h>
 
 
-// dict with cached NSDateFormatter objects, keys are the formatter strings
-static NSMutableDictionary *__cachedDateFormatters;
+// Reads a number with exactly count digits and moves the cursor behind it.
+static inline BOOL INISO8601ReadDigits(const char **cursor, const char *end, NSUInteger count, NSInteger *value) {
+    const char *characters = *cursor;
+    if ((size_t)(end - characters) < count) {
+        return NO;
+    }
+    NSInteger result = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        char character = characters[index];
+        if (character < '0' || character > '9') {
+            return NO;
+        }
+        result = result * 10 + (character - '0');
+    }
+    *value = result;
+    *cursor = characters + count;
+    return YES;
+}
+
+// Moves the cursor behind the character if it's the next one.
+static inline BOOL INISO8601ReadCharacter(const char **cursor, const char *end, char character) {
+    if (*cursor < end && **cursor == character) {
+        (*cursor)++;
+        return YES;
+    }
+    return NO;
+}
+
+BOOL INISO8601ParseUTF8(const char *string, size_t length, NSTimeInterval *timeInterval, INDateInformation *dateInfo) {
+    const char *cursor = string;
+    const char *end = string + length;
+    NSInteger year, month, day;
+    NSInteger hour = 0, minute = 0, second = 0, secondsFromGMT = 0;
+    NSTimeInterval fraction = 0;
+
+    if (!INISO8601ReadDigits(&cursor, end, 4, &year) || !INISO8601ReadCharacter(&cursor, end, '-')
+        || !INISO8601ReadDigits(&cursor, end, 2, &month) || !INISO8601ReadCharacter(&cursor, end, '-')
+        || !INISO8601ReadDigits(&cursor, end, 2, &day)) {
+        return NO;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > INDateDaysInMonth(year, month)) {
+        return NO;
+    }
+
+    if (cursor < end) {
+        char separator = *cursor++;
+        if (separator != 'T' && separator != 't' && separator != ' ') {
+            return NO;
+        }
+        if (!INISO8601ReadDigits(&cursor, end, 2, &hour) || !INISO8601ReadCharacter(&cursor, end, ':') || !INISO8601ReadDigits(&cursor, end, 2, &minute)) {
+            return NO;
+        }
+        if (INISO8601ReadCharacter(&cursor, end, ':')) {
+            if (!INISO8601ReadDigits(&cursor, end, 2, &second)) {
+                return NO;
+            }
+            if (INISO8601ReadCharacter(&cursor, end, '.') || INISO8601ReadCharacter(&cursor, end, ',')) {
+                // more digits than a double can hold are ignored
+                int64_t fractionValue = 0;
+                double divisor = 1;
+                const char *digits = cursor;
+                for (; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++) {
+                    if (cursor - digits < 9) {
+                        fractionValue = fractionValue * 10 + (*cursor - '0');
+                        divisor *= 10;
+                    }
+                }
+                if (cursor == digits) {
+                    return NO;
+                }
+                fraction = fractionValue / divisor;
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 59) {
+            return NO;
+        }
+
+        if (cursor < end) {
+            char sign = *cursor++;
+            if (sign == '+' || sign == '-') {
+                NSInteger offsetHours, offsetMinutes = 0;
+                if (!INISO8601ReadDigits(&cursor, end, 2, &offsetHours)) {
+                    return NO;
+                }
+                BOOL hasColon = INISO8601ReadCharacter(&cursor, end, ':');
+                if ((hasColon || cursor < end) && !INISO8601ReadDigits(&cursor, end, 2, &offsetMinutes)) {
+                    return NO;
+                }
+                if (offsetHours > 23 || offsetMinutes > 59) {
+                    return NO;
+                }
+                secondsFromGMT = (offsetHours * 3600 + offsetMinutes * 60) * (sign == '-' ? -1 : 1);
+            } else if (sign != 'Z' && sign != 'z') {
+                return NO;
+            }
+        }
+    }
+    if (cursor != end) {
+        return NO;
+    }
+
+    if (timeInterval != NULL) {
+        int64_t seconds = INDateSecondsFromCivil(year, month, day, hour, minute, second) - secondsFromGMT - (int64_t)NSTimeIntervalSince1970;
+        *timeInterval = (NSTimeInterval)seconds + fraction;
+    }
+    if (dateInfo != NULL) {
+        *dateInfo = INDateInformationMake(year, month, day, hour, minute, second);
+        dateInfo->weekday = INDateWeekdayFromDays(INDateDaysFromCivil(year, month, day));
+    }
+    return YES;
+}
+
+BOOL INISO8601ParseString(NSString *string, NSTimeInterval *timeInterval, INDateInformation *dateInfo) {
+    if (string == nil) {
+        return NO;
+    }
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    const char *characters = CFStringGetCStringPtr(cfString, kCFStringEncodingASCII);
+    if (characters != NULL) {
+        return INISO8601ParseUTF8(characters, (size_t)length, timeInterval, dateInfo);
+    }
+
+    // copy into a buffer on the stack, strings longer than the buffer or with non ASCII characters are no valid dates anyway
+    char buffer[64];
+    if (length > (CFIndex)sizeof(buffer)) {
+        return NO;
+    }
+    CFIndex usedLength = 0;
+    CFIndex convertedLength = CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingASCII, 0, false, (UInt8 *)buffer, sizeof(buffer), &usedLength);
+    if (convertedLength != length) {
+        return NO;
+    }
+    return INISO8601ParseUTF8(buffer, (size_t)usedLength, timeInterval, dateInfo);
+}
+
+// Writes a number with exactly count digits and returns the position behind it.
+static inline char *INISO8601WriteDigits(char *cursor, int64_t value, NSUInteger count) {
+    for (NSUInteger index = count; index > 0; index--) {
+        cursor[index - 1] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    return cursor + count;
+}
+
+size_t INISO8601FormatUTF8(NSTimeInterval timeInterval, NSInteger secondsFromGMT, NSUInteger fractionDigits, char *buffer, size_t bufferSize) {
+    fractionDigits = MIN(fractionDigits, (NSUInteger)6);
+    NSInteger offsetMinutes = secondsFromGMT / 60;
+    size_t length = 19 + (fractionDigits > 0 ? fractionDigits + 1 : 0) + (offsetMinutes != 0 ? 6 : 1);
+    if (bufferSize < length + 1) {
+        return 0;
+    }
+
+    // truncate the fractions on the time since 1970 like NSDateFormatter
+    int64_t scale = 1;
+    for (NSUInteger index = 0; index < fractionDigits; index++) {
+        scale *= 10;
+    }
+    int64_t units = (int64_t)floor((timeInterval + NSTimeIntervalSince1970) * scale);
+    int64_t seconds = INDateFloorDivide(units, scale);
+    int64_t fractionUnits = units - seconds * scale;
+    int64_t localSeconds = seconds + offsetMinutes * 60;
+    int64_t days = INDateFloorDivide(localSeconds, INDateSecondsPerDay);
+    NSInteger secondsOfDay = (NSInteger)(localSeconds - days * INDateSecondsPerDay);
+    NSInteger year, month, day;
+    INDateCivilFromDays((NSInteger)days, &year, &month, &day);
+    if (year < 0 || year > 9999) {
+        return 0;
+    }
+
+    char *cursor = buffer;
+    cursor = INISO8601WriteDigits(cursor, year, 4);
+    *cursor++ = '-';
+    cursor = INISO8601WriteDigits(cursor, month, 2);
+    *cursor++ = '-';
+    cursor = INISO8601WriteDigits(cursor, day, 2);
+    *cursor++ = 'T';
+    cursor = INISO8601WriteDigits(cursor, secondsOfDay / 3600, 2);
+    *cursor++ = ':';
+    cursor = INISO8601WriteDigits(cursor, secondsOfDay / 60 % 60, 2);
+    *cursor++ = ':';
+    cursor = INISO8601WriteDigits(cursor, secondsOfDay % 60, 2);
+    if (fractionDigits > 0) {
+        *cursor++ = '.';
+        cursor = INISO8601WriteDigits(cursor, fractionUnits, fractionDigits);
+    }
+    if (offsetMinutes == 0) {
+        *cursor++ = 'Z';
+    } else {
+        *cursor++ = offsetMinutes < 0 ? '-' : '+';
+        NSInteger absoluteMinutes = ABS(offsetMinutes);
+        cursor = INISO8601WriteDigits(cursor, absoluteMinutes / 60, 2);
+        *cursor++ = ':';
+        cursor = INISO8601WriteDigits(cursor, absoluteMinutes % 60, 2);
+    }
+    *cursor = '\0';
+    return length;
+}
+
+NSString *INISO8601StringFromTimeInterval(NSTimeInterval timeInterval, NSInteger secondsFromGMT, NSUInteger fractionDigits) {
+    char buffer[INISO8601MaximumLength + 1];
+    size_t length = INISO8601FormatUTF8(timeInterval, secondsFromGMT, fractionDigits, buffer, sizeof(buffer));
+    if (length == 0) {
+        return nil;
+    }
+    return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
+
+// the kinds of operations of a compiled date pattern
+typedef NS_ENUM(uint8_t, INDatePatternField) {
+    INDatePatternFieldLiteral,
+    // y, yyy.., the width is the minimum number of digits
+    INDatePatternFieldYear,
+    // yy
+    INDatePatternFieldYearTwoDigits,
+    // M, MM, L, LL
+    INDatePatternFieldMonth,
+    // MMM.., LLL.., the width is the names table
+    INDatePatternFieldMonthName,
+    // d, dd
+    INDatePatternFieldDay,
+    // D..DDD
+    INDatePatternFieldDayOfYear,
+    // E..EEEEE, the width is the names table
+    INDatePatternFieldWeekdayName,
+    // H 0..23
+    INDatePatternFieldHour23,
+    // k 1..24
+    INDatePatternFieldHour24,
+    // h 1..12
+    INDatePatternFieldHour12,
+    // K 0..11
+    INDatePatternFieldHour11,
+    // m, mm
+    INDatePatternFieldMinute,
+    // s, ss
+    INDatePatternFieldSecond,
+    // S.., the width is the number of digits
+    INDatePatternFieldFraction,
+    // a
+    INDatePatternFieldAMPM,
+    // Z..ZZZ as +hhmm
+    INDatePatternFieldOffset,
+    // ZZZZZ as +hh:mm or Z
+    INDatePatternFieldOffsetExtended,
+};
+
+// the tables of names taken from the locale
+typedef NS_ENUM(uint8_t, INDatePatternNameTable) {
+    INDatePatternNameTableMonths,
+    INDatePatternNameTableShortMonths,
+    INDatePatternNameTableNarrowMonths,
+    INDatePatternNameTableStandaloneMonths,
+    INDatePatternNameTableShortStandaloneMonths,
+    INDatePatternNameTableNarrowStandaloneMonths,
+    INDatePatternNameTableWeekdays,
+    INDatePatternNameTableShortWeekdays,
+    INDatePatternNameTableNarrowWeekdays,
+    INDatePatternNameTableAMPM,
+    INDatePatternNameTableCount
+};
+
+// The names of a locale as UTF-8 strings in one buffer.
+typedef struct INDatePatternNames {
+    const char *bytes;
+    uint32_t offsets[INDatePatternNameTableCount][12];
+    uint32_t lengths[INDatePatternNameTableCount][12];
+} INDatePatternNames;
+
+// One operation of a compiled date pattern.
+typedef struct INDatePatternOperation {
+    INDatePatternField field;
+    // the minimum number of digits or the names table
+    uint8_t width;
+    // the range of a literal in the pattern's literals
+    uint32_t offset;
+    uint32_t length;
+} INDatePatternOperation;
+
+// Collects the output of a pattern like snprintf, counting the characters which don't fit.
+typedef struct INDatePatternWriter {
+    char *buffer;
+    size_t size;
+    size_t length;
+} INDatePatternWriter;
+
+static inline void INDatePatternWriteBytes(INDatePatternWriter *writer, const char *bytes, size_t count) {
+    if (writer->length < writer->size) {
+        memcpy(writer->buffer + writer->length, bytes, MIN(count, writer->size - writer->length));
+    }
+    writer->length += count;
+}
+
+static inline void INDatePatternWriteNumber(INDatePatternWriter *writer, int64_t value, NSUInteger minimumDigits) {
+    char digits[32];
+    size_t count = 0;
+    uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+    do {
+        digits[sizeof(digits) - ++count] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    while (count < minimumDigits && count < sizeof(digits) - 1) {
+        digits[sizeof(digits) - ++count] = '0';
+    }
+    if (value < 0) {
+        digits[sizeof(digits) - ++count] = '-';
+    }
+    INDatePatternWriteBytes(writer, digits + sizeof(digits) - count, count);
+}
+
+// Maps a run of a pattern letter to its operation, returns false for unsupported fields.
+static BOOL INDatePatternOperationForLetter(unichar letter, NSUInteger count, INDatePatternOperation *operation) {
+    operation->width = (uint8_t)MIN(count, (NSUInteger)UINT8_MAX);
+    switch (letter) {
+        case 'y':
+            operation->field = count == 2 ? INDatePatternFieldYearTwoDigits : INDatePatternFieldYear;
+            return YES;
+        case 'M':
+        case 'L':
+            if (count <= 2) {
+                operation->field = INDatePatternFieldMonth;
+                return YES;
+            }
+            if (count > 5) {
+                return NO;
+            }
+            operation->field = INDatePatternFieldMonthName;
+            operation->width = (letter == 'M' ? INDatePatternNameTableMonths : INDatePatternNameTableStandaloneMonths) + (count == 4 ? 0 : count == 3 ? 1 : 2);
+            return YES;
+        case 'd':
+            operation->field = INDatePatternFieldDay;
+            return count <= 2;
+        case 'D':
+            operation->field = INDatePatternFieldDayOfYear;
+            return count <= 3;
+        case 'E':
+            if (count > 5) {
+                return NO;
+            }
+            operation->field = INDatePatternFieldWeekdayName;
+            operation->width = count == 4 ? INDatePatternNameTableWeekdays : count == 5 ? INDatePatternNameTableNarrowWeekdays : INDatePatternNameTableShortWeekdays;
+            return YES;
+        case 'a':
+            operation->field = INDatePatternFieldAMPM;
+            return count <= 3;
+        case 'H':
+            operation->field = INDatePatternFieldHour23;
+            return count <= 2;
+        case 'k':
+            operation->field = INDatePatternFieldHour24;
+            return count <= 2;
+        case 'h':
+            operation->field = INDatePatternFieldHour12;
+            return count <= 2;
+        case 'K':
+            operation->field = INDatePatternFieldHour11;
+            return count <= 2;
+        case 'm':
+            operation->field = INDatePatternFieldMinute;
+            return count <= 2;
+        case 's':
+            operation->field = INDatePatternFieldSecond;
+            return count <= 2;
+        case 'S':
+            operation->field = INDatePatternFieldFraction;
+            return YES;
+        case 'Z':
+            operation->field = count == 5 ? INDatePatternFieldOffsetExtended : INDatePatternFieldOffset;
+            return count <= 3 || count == 5;
+        default:
+            return NO;
+    }
+}
+
+static NSInteger INDatePatternTimeZoneOffset(const void *context, NSTimeInterval timeInterval) {
+    return (NSInteger)CFTimeZoneGetSecondsFromGMT((CFTimeZoneRef)context, timeInterval);
+}
+
+
+// The names of one locale, created only once for each locale.
+@interface INDatePatternNameTables : NSObject
+
++ (INDatePatternNameTables *)nameTablesForLocale:(NSLocale *)locale;
+
+- (const INDatePatternNames *)names;
+
+@end
+
+
+@implementation INDatePatternNameTables {
+    NSMutableData *_bytes;
+    INDatePatternNames _names;
+}
+
++ (INDatePatternNameTables *)nameTablesForLocale:(NSLocale *)locale {
+    static NSMutableDictionary *nameTablesByLocale = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        nameTablesByLocale = [[NSMutableDictionary alloc] init];
+    });
+
+    NSString *identifier = locale.localeIdentifier;
+    @synchronized(nameTablesByLocale) {
+        INDatePatternNameTables *nameTables = nameTablesByLocale[identifier];
+        if (nameTables == nil) {
+            nameTables = [[INDatePatternNameTables alloc] initWithLocale:locale];
+            nameTablesByLocale[identifier] = nameTables;
+        }
+        return nameTables;
+    }
+}
+
+- (instancetype)initWithLocale:(NSLocale *)locale {
+    self = [super init];
+    if (self == nil) return self;
+
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    formatter.locale = locale;
+    NSArray *tables = @[formatter.monthSymbols ?: @[], formatter.shortMonthSymbols ?: @[], formatter.veryShortMonthSymbols ?: @[],
+                        formatter.standaloneMonthSymbols ?: @[], formatter.shortStandaloneMonthSymbols ?: @[], formatter.veryShortStandaloneMonthSymbols ?: @[],
+                        formatter.weekdaySymbols ?: @[], formatter.shortWeekdaySymbols ?: @[], formatter.veryShortWeekdaySymbols ?: @[],
+                        @[formatter.AMSymbol ?: @"AM", formatter.PMSymbol ?: @"PM"]];
+    _bytes = [[NSMutableData alloc] init];
+    for (NSUInteger table = 0; table < INDatePatternNameTableCount; table++) {
+        NSArray *names = tables[table];
+        for (NSUInteger index = 0; index < 12; index++) {
+            NSData *name = index < names.count ? [names[index] dataUsingEncoding:NSUTF8StringEncoding] : nil;
+            _names.offsets[table][index] = (uint32_t)_bytes.length;
+            _names.lengths[table][index] = (uint32_t)name.length;
+            [_bytes appendData:name];
+        }
+    }
+    _names.bytes = _bytes.bytes;
+
+    return self;
+}
+
+- (const INDatePatternNames *)names {
+    return &_names;
+}
+
+@end
+
+
+@implementation INDatePattern {
+    NSMutableData *_operations;
+    NSMutableData *_literals;
+    INDatePatternNameTables *_nameTables;
+    // the number of fraction digits time intervals have to be split into
+    NSUInteger _fractionDigits;
+    BOOL _usesOffset;
+}
+
++ (instancetype)patternWithFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone {
+    return [[self alloc] initWithFormat:format locale:locale timeZone:timeZone];
+}
+
+- (instancetype)initWithFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone {
+    self = [super init];
+    if (self == nil) return self;
+
+    _format = [format copy];
+    _locale = locale ?: [NSLocale currentLocale];
+    _timeZone = timeZone ?: [NSTimeZone defaultTimeZone];
+    _operations = [[NSMutableData alloc] init];
+    _literals = [[NSMutableData alloc] init];
+    if (![self compileFormat:_format]) {
+        return nil;
+    }
+    _nameTables = [INDatePatternNameTables nameTablesForLocale:_locale];
+
+    return self;
+}
+
+- (void)addLiteral:(NSMutableString *)literal {
+    if (literal.length == 0) {
+        return;
+    }
+    NSData *bytes = [literal dataUsingEncoding:NSUTF8StringEncoding];
+    INDatePatternOperation operation = {INDatePatternFieldLiteral, 0, (uint32_t)_literals.length, (uint32_t)bytes.length};
+    [_literals appendData:bytes];
+    [_operations appendBytes:&operation length:sizeof(operation)];
+    [literal setString:@""];
+}
+
+- (BOOL)compileFormat:(NSString *)format {
+    NSUInteger length = format.length;
+    NSMutableString *literal = [NSMutableString string];
+    NSUInteger index = 0;
+    while (index < length) {
+        unichar character = [format characterAtIndex:index];
+        if (character == '\'') {
+            // text in quotes is a literal, two quotes are one quote inside and outside of quoted text
+            if (index + 1 < length && [format characterAtIndex:index + 1] == '\'') {
+                [literal appendString:@"'"];
+                index += 2;
+                continue;
+            }
+            for (index++; index < length; index++) {
+                unichar quoted = [format characterAtIndex:index];
+                if (quoted == '\'') {
+                    if (index + 1 < length && [format characterAtIndex:index + 1] == '\'') {
+                        index++;
+                    } else {
+                        index++;
+                        break;
+                    }
+                }
+                CFStringAppendCharacters((__bridge CFMutableStringRef)literal, &quoted, 1);
+            }
+            continue;
+        }
+        if ((character < 'a' || character > 'z') && (character < 'A' || character > 'Z')) {
+            CFStringAppendCharacters((__bridge CFMutableStringRef)literal, &character, 1);
+            index++;
+            continue;
+        }
+
+        NSUInteger count = 1;
+        while (index + count < length && [format characterAtIndex:index + count] == character) {
+            count++;
+        }
+        index += count;
+        INDatePatternOperation operation = {INDatePatternFieldLiteral, 0, 0, 0};
+        if (!INDatePatternOperationForLetter(character, count, &operation)) {
+            return NO;
+        }
+        [self addLiteral:literal];
+        [_operations appendBytes:&operation length:sizeof(operation)];
+        if (operation.field == INDatePatternFieldFraction) {
+            _fractionDigits = MAX(_fractionDigits, MIN(count, (NSUInteger)6));
+        } else if (operation.field == INDatePatternFieldOffset || operation.field == INDatePatternFieldOffsetExtended) {
+            _usesOffset = YES;
+        }
+    }
+    [self addLiteral:literal];
+    return YES;
+}
+
+
+#pragma mark - Formatting into buffers
+
+// Writes a local date and time, fractionUnits are the fractions of the second in units of the pattern's fraction digits.
+- (size_t)writeDateInformation:(INDateInformation)dateInfo fractionUnits:(int64_t)fractionUnits secondsFromGMT:(NSInteger)secondsFromGMT intoBuffer:(char *)buffer size:(size_t)bufferSize {
+    INDatePatternWriter writer = {buffer, bufferSize, 0};
+    const INDatePatternOperation *operations = _operations.bytes;
+    NSUInteger count = _operations.length / sizeof(INDatePatternOperation);
+    const char *literals = _literals.bytes;
+    const INDatePatternNames *names = [_nameTables names];
+    NSInteger days = INDateDaysFromCivil(dateInfo.year, dateInfo.month, dateInfo.day);
+    NSInteger monthIndex = MAX(0, MIN(11, dateInfo.month - 1));
+
+    for (NSUInteger index = 0; index < count; index++) {
+        const INDatePatternOperation *operation = &operations[index];
+        switch (operation->field) {
+            case INDatePatternFieldLiteral:
+                INDatePatternWriteBytes(&writer, literals + operation->offset, operation->length);
+                break;
+            case INDatePatternFieldYear:
+                INDatePatternWriteNumber(&writer, dateInfo.year, operation->width);
+                break;
+            case INDatePatternFieldYearTwoDigits:
+                INDatePatternWriteNumber(&writer, (dateInfo.year % 100 + 100) % 100, 2);
+                break;
+            case INDatePatternFieldMonth:
+                INDatePatternWriteNumber(&writer, dateInfo.month, operation->width);
+                break;
+            case INDatePatternFieldMonthName:
+                INDatePatternWriteBytes(&writer, names->bytes + names->offsets[operation->width][monthIndex], names->lengths[operation->width][monthIndex]);
+                break;
+            case INDatePatternFieldDay:
+                INDatePatternWriteNumber(&writer, dateInfo.day, operation->width);
+                break;
+            case INDatePatternFieldDayOfYear:
+                INDatePatternWriteNumber(&writer, INDateDayOfYearFromDays(days, dateInfo.year), operation->width);
+                break;
+            case INDatePatternFieldWeekdayName: {
+                NSInteger weekdayIndex = INDateWeekdayFromDays(days) - 1;
+                INDatePatternWriteBytes(&writer, names->bytes + names->offsets[operation->width][weekdayIndex], names->lengths[operation->width][weekdayIndex]);
+                break;
+            }
+            case INDatePatternFieldHour23:
+                INDatePatternWriteNumber(&writer, dateInfo.hour, operation->width);
+                break;
+            case INDatePatternFieldHour24:
+                INDatePatternWriteNumber(&writer, dateInfo.hour == 0 ? 24 : dateInfo.hour, operation->width);
+                break;
+            case INDatePatternFieldHour12:
+                INDatePatternWriteNumber(&writer, dateInfo.hour % 12 == 0 ? 12 : dateInfo.hour % 12, operation->width);
+                break;
+            case INDatePatternFieldHour11:
+                INDatePatternWriteNumber(&writer, dateInfo.hour % 12, operation->width);
+                break;
+            case INDatePatternFieldMinute:
+                INDatePatternWriteNumber(&writer, dateInfo.minute, operation->width);
+                break;
+            case INDatePatternFieldSecond:
+                INDatePatternWriteNumber(&writer, dateInfo.second, operation->width);
+                break;
+            case INDatePatternFieldFraction: {
+                // truncate to the wanted digits and fill up with zeros beyond the precision of the fraction units
+                NSUInteger digits = MIN((NSUInteger)operation->width, _fractionDigits);
+                int64_t units = fractionUnits;
+                for (NSUInteger digit = digits; digit < _fractionDigits; digit++) {
+                    units /= 10;
+                }
+                INDatePatternWriteNumber(&writer, units, digits);
+                for (NSUInteger digit = digits; digit < operation->width; digit++) {
+                    INDatePatternWriteBytes(&writer, "0", 1);
+                }
+                break;
+            }
+            case INDatePatternFieldAMPM: {
+                NSUInteger symbolIndex = dateInfo.hour < 12 ? 0 : 1;
+                INDatePatternWriteBytes(&writer, names->bytes + names->offsets[INDatePatternNameTableAMPM][symbolIndex], names->lengths[INDatePatternNameTableAMPM][symbolIndex]);
+                break;
+            }
+            case INDatePatternFieldOffset:
+            case INDatePatternFieldOffsetExtended: {
+                NSInteger offsetMinutes = secondsFromGMT / 60;
+                if (offsetMinutes == 0 && operation->field == INDatePatternFieldOffsetExtended) {
+                    INDatePatternWriteBytes(&writer, "Z", 1);
+                    break;
+                }
+                NSInteger absoluteMinutes = ABS(offsetMinutes);
+                INDatePatternWriteBytes(&writer, offsetMinutes < 0 ? "-" : "+", 1);
+                INDatePatternWriteNumber(&writer, absoluteMinutes / 60, 2);
+                if (operation->field == INDatePatternFieldOffsetExtended) {
+                    INDatePatternWriteBytes(&writer, ":", 1);
+                }
+                INDatePatternWriteNumber(&writer, absoluteMinutes % 60, 2);
+                break;
+            }
+        }
+    }
+
+    if (bufferSize > 0) {
+        buffer[MIN(writer.length, bufferSize - 1)] = '\0';
+    }
+    return writer.length;
+}
+
+- (size_t)formatDateInformation:(INDateInformation)dateInfo intoBuffer:(char *)buffer size:(size_t)bufferSize {
+    NSInteger secondsFromGMT = 0;
+    if (_usesOffset) {
+        NSTimeInterval localTimeInterval = (NSTimeInterval)(INDateSecondsFromCivil(dateInfo.year, dateInfo.month, dateInfo.day, dateInfo.hour, dateInfo.minute, dateInfo.second) - (int64_t)NSTimeIntervalSince1970);
+        CFTimeZoneRef timeZone = (__bridge CFTimeZoneRef)_timeZone;
+        NSTimeInterval timeInterval = INDateTimeIntervalFromLocalTimeInterval(localTimeInterval, INDatePatternTimeZoneOffset, timeZone);
+        secondsFromGMT = (NSInteger)CFTimeZoneGetSecondsFromGMT(timeZone, timeInterval);
+    }
+    return [self writeDateInformation:dateInfo fractionUnits:0 secondsFromGMT:secondsFromGMT intoBuffer:buffer size:bufferSize];
+}
+
+- (size_t)formatTimeInterval:(NSTimeInterval)timeInterval intoBuffer:(char *)buffer size:(size_t)bufferSize {
+    // truncate the fractions on the time since 1970 like NSDateFormatter
+    int64_t scale = 1;
+    for (NSUInteger index = 0; index < _fractionDigits; index++) {
+        scale *= 10;
+    }
+    int64_t units = (int64_t)floor((timeInterval + NSTimeIntervalSince1970) * scale);
+    int64_t seconds = INDateFloorDivide(units, scale);
+    NSTimeInterval wholeTimeInterval = (NSTimeInterval)(seconds - (int64_t)NSTimeIntervalSince1970);
+    NSInteger secondsFromGMT = (NSInteger)CFTimeZoneGetSecondsFromGMT((__bridge CFTimeZoneRef)_timeZone, wholeTimeInterval);
+    INDateInformation dateInfo = INDateInformationFromTimeInterval(wholeTimeInterval, secondsFromGMT);
+    return [self writeDateInformation:dateInfo fractionUnits:units - seconds * scale secondsFromGMT:secondsFromGMT intoBuffer:buffer size:bufferSize];
+}
+
+
+#pragma mark - Formatting into strings
+
+- (void)appendDateInformation:(INDateInformation)dateInfo toString:(NSMutableString *)string {
+    char buffer[256];
+    size_t length = [self formatDateInformation:dateInfo intoBuffer:buffer size:sizeof(buffer)];
+    if (length < sizeof(buffer)) {
+        CFStringAppendCString((__bridge CFMutableStringRef)string, buffer, kCFStringEncodingUTF8);
+        return;
+    }
+    char *heapBuffer = malloc(length + 1);
+    [self formatDateInformation:dateInfo intoBuffer:heapBuffer size:length + 1];
+    CFStringAppendCString((__bridge CFMutableStringRef)string, heapBuffer, kCFStringEncodingUTF8);
+    free(heapBuffer);
+}
+
+- (void)appendTimeInterval:(NSTimeInterval)timeInterval toString:(NSMutableString *)string {
+    char buffer[256];
+    size_t length = [self formatTimeInterval:timeInterval intoBuffer:buffer size:sizeof(buffer)];
+    if (length < sizeof(buffer)) {
+        CFStringAppendCString((__bridge CFMutableStringRef)string, buffer, kCFStringEncodingUTF8);
+        return;
+    }
+    char *heapBuffer = malloc(length + 1);
+    [self formatTimeInterval:timeInterval intoBuffer:heapBuffer size:length + 1];
+    CFStringAppendCString((__bridge CFMutableStringRef)string, heapBuffer, kCFStringEncodingUTF8);
+    free(heapBuffer);
+}
+
+- (NSString *)stringFromDateInformation:(INDateInformation)dateInfo {
+    char buffer[256];
+    size_t length = [self formatDateInformation:dateInfo intoBuffer:buffer size:sizeof(buffer)];
+    if (length < sizeof(buffer)) {
+        return [[NSString alloc] initWithBytes:buffer length:length encoding:NSUTF8StringEncoding];
+    }
+    NSMutableString *string = [NSMutableString string];
+    [self appendDateInformation:dateInfo toString:string];
+    return string;
+}
+
+- (NSString *)stringFromTimeInterval:(NSTimeInterval)timeInterval {
+    char buffer[256];
+    size_t length = [self formatTimeInterval:timeInterval intoBuffer:buffer size:sizeof(buffer)];
+    if (length < sizeof(buffer)) {
+        return [[NSString alloc] initWithBytes:buffer length:length encoding:NSUTF8StringEncoding];
+    }
+    NSMutableString *string = [NSMutableString string];
+    [self appendTimeInterval:timeInterval toString:string];
+    return string;
+}
+
+@end
+
+
+// maximum number of formatters cached for each thread
+static const NSUInteger INDateFormatterCacheSize = 16;
+
+// key for the current thread's INThreadDateFormatterCache in the thread dictionary
+static NSString * const INThreadDateFormatterCacheKey = @"INExtensions_threadDateFormatterCache";
+
+// incremented each time all threads have to remove their cached formatters
+static atomic_uint __dateFormatterCacheGeneration = 0;
+
+// number of strings from which on parsing is split up and done concurrently
+static const NSUInteger INDateParsingConcurrentThreshold = 1024;
+
+// number of strings parsed within one autorelease pool
+static const NSUInteger INDateParsingPoolSize = 256;
+
+
+// A cached formatter and pattern with the values they have been created for, both are created when first needed.
+@interface INCachedDateFormatter : NSObject
+
+@property (nonatomic, copy) NSString *format;
+@property (nonatomic, strong) NSLocale *locale;
+@property (nonatomic, strong) NSTimeZone *timeZone;
+@property (nonatomic, strong, readonly) NSDateFormatter *formatter;
+@property (nonatomic, strong, readonly) INDatePattern *pattern;
+
+@end
+
+
+@implementation INCachedDateFormatter {
+    // the pattern may be nil for unsupported formats
+    BOOL _patternCompiled;
+}
+
+@synthesize formatter = _formatter;
+@synthesize pattern = _pattern;
+
+- (NSDateFormatter *)formatter {
+    if (_formatter == nil) {
+        _formatter = [[NSDateFormatter alloc] init];
+        _formatter.locale = self.locale;
+        _formatter.timeZone = self.timeZone;
+        [_formatter setDateFormat:self.format];
+    }
+    return _formatter;
+}
+
+- (INDatePattern *)pattern {
+    if (!_patternCompiled) {
+        _pattern = [[INDatePattern alloc] initWithFormat:self.format locale:self.locale timeZone:self.timeZone];
+        _patternCompiled = YES;
+    }
+    return _pattern;
+}
+
+@end
+
+
+// The formatters of one thread, the most recently used first.
+@interface INThreadDateFormatterCache : NSObject
+
+- (INCachedDateFormatter *)entryForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone;
+
+@end
+
+
+@implementation INThreadDateFormatterCache {
+    NSMutableArray *_entries;
+    NSUInteger _generation;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self == nil) return self;
+
+    _entries = [[NSMutableArray alloc] initWithCapacity:INDateFormatterCacheSize];
+    _generation = atomic_load(&__dateFormatterCacheGeneration);
+
+    return self;
+}
+
+- (INCachedDateFormatter *)entryForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone {
+    NSUInteger generation = atomic_load(&__dateFormatterCacheGeneration);
+    if (generation != _generation) {
+        [_entries removeAllObjects];
+        _generation = generation;
+    }
+
+    NSUInteger count = _entries.count;
+    for (NSUInteger index = 0; index < count; index++) {
+        INCachedDateFormatter *entry = _entries[index];
+        if ((entry.format == format || [entry.format isEqualToString:format])
+            && (entry.locale == locale || [entry.locale isEqual:locale])
+            && (entry.timeZone == timeZone || [entry.timeZone isEqualToTimeZone:timeZone])) {
+            if (index > 0) {
+                [_entries removeObjectAtIndex:index];
+                [_entries insertObject:entry atIndex:0];
+            }
+            return entry;
+        }
+    }
+
+    INCachedDateFormatter *entry = [[INCachedDateFormatter alloc] init];
+    entry.format = format;
+    entry.locale = locale;
+    entry.timeZone = timeZone;
+    if (count >= INDateFormatterCacheSize) {
+        [_entries removeLastObject];
+    }
+    [_entries insertObject:entry atIndex:0];
+    return entry;
+}
+
+@end
 
 
 @implementation NSDateFormatter (INExtensions)
 
 + (NSDateFormatter *)cachedDateFormatterForFormat:(NSString *)format {
+    return [self cachedDateFormatterForFormat:format locale:nil timeZone:nil];
+}
+
++ (NSDateFormatter *)cachedDateFormatterForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone {
+    return [self cachedEntryForFormat:format locale:locale timeZone:timeZone].formatter;
+}
+
++ (INDatePattern *)cachedDatePatternForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone {
+    return [self cachedEntryForFormat:format locale:locale timeZone:timeZone].pattern;
+}
+
++ (NSIndexSet *)parseDateStrings:(NSArray *)strings withFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone intoTimeIntervals:(NSTimeInterval *)timeIntervals {
+    return [self parseDateStringsWithCount:strings.count format:format locale:locale timeZone:timeZone intoTimeIntervals:timeIntervals stringAtIndex:^NSString *(NSUInteger index) {
+        id string = strings[index];
+        return [string isKindOfClass:[NSString class]] ? string : nil;
+    }];
+}
+
++ (NSIndexSet *)parseUTF8DateStrings:(const char * const *)strings count:(NSUInteger)count withFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone intoTimeIntervals:(NSTimeInterval *)timeIntervals {
+    return [self parseDateStringsWithCount:count format:format locale:locale timeZone:timeZone intoTimeIntervals:timeIntervals stringAtIndex:^NSString *(NSUInteger index) {
+        const char *string = strings[index];
+        if (string == NULL) {
+            return nil;
+        }
+        return [[NSString alloc] initWithBytesNoCopy:(void *)string length:strlen(string) encoding:NSUTF8StringEncoding freeWhenDone:NO];
+    }];
+}
+
+// Parses the strings returned by the block in chunks on all cores, invalid strings get NAN and are collected afterwards.
++ (NSIndexSet *)parseDateStringsWithCount:(NSUInteger)count format:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone intoTimeIntervals:(NSTimeInterval *)timeIntervals stringAtIndex:(NSString *(^)(NSUInteger index))stringAtIndex {
+    // resolve the defaults once, so all workers use the same values
+    if (locale == nil) {
+        locale = [NSLocale currentLocale];
+    }
+    if (timeZone == nil) {
+        timeZone = [NSTimeZone defaultTimeZone];
+    }
+
+    INChunksEnumerate(INChunksMake(count, INDateParsingConcurrentThreshold, 0), ^(NSRange range, NSUInteger chunk, BOOL *stop) {
+        NSDateFormatter *formatter = [self cachedDateFormatterForFormat:format locale:locale timeZone:timeZone];
+        for (NSUInteger poolStart = range.location; poolStart < NSMaxRange(range); poolStart += INDateParsingPoolSize) {
+            @autoreleasepool {
+                NSUInteger poolEnd = MIN(poolStart + INDateParsingPoolSize, NSMaxRange(range));
+                for (NSUInteger index = poolStart; index < poolEnd; index++) {
+                    NSString *string = stringAtIndex(index);
+                    NSDate *date = string != nil ? [formatter dateFromString:string] : nil;
+                    timeIntervals[index] = date != nil ? [date timeIntervalSinceReferenceDate] : NAN;
+                }
+            }
+        }
+    });
+
+    NSMutableIndexSet *invalidIndexes = [NSMutableIndexSet indexSet];
+    for (NSUInteger index = 0; index < count; index++) {
+        if (isnan(timeIntervals[index])) {
+            [invalidIndexes addIndex:index];
+        }
+    }
+    return invalidIndexes;
+}
+
+// Returns the current thread's cache entry for the values.
++ (INCachedDateFormatter *)cachedEntryForFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone {
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        __cachedDateFormatters = [[NSMutableDictionary alloc] initWithCapacity:10];
-        
-        // add observer for clearing the cache
-        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:[UIApplication sharedApplication] queue:nil usingBlock:^(NSNotification *notification){
-            @synchronized(__cachedDateFormatters) {
-                [__cachedDateFormatters removeAllObjects];
-            }
+        // add observers for clearing the caches of all threads
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        for (NSString *name in @[NSCurrentLocaleDidChangeNotification, NSSystemTimeZoneDidChangeNotification]) {
+            [center addObserverForName:name object:nil queue:nil usingBlock:^(NSNotification *notification) {
+                atomic_fetch_add(&__dateFormatterCacheGeneration, 1);
+            }];
+        }
+        [center addObserverForName:UIApplicationDidReceiveMemoryWarningNotification object:[UIApplication sharedApplication] queue:nil usingBlock:^(NSNotification *notification){
+            atomic_fetch_add(&__dateFormatterCacheGeneration, 1);
         }];
     });
-    
-    NSDateFormatter *dateFormatter = nil;
-    @synchronized (__cachedDateFormatters) {
-        dateFormatter = [__cachedDateFormatters objectForKey:format];
-        if (dateFormatter == nil) {
-            dateFormatter = [[NSDateFormatter alloc] init];
-            [dateFormatter setDateFormat:format];
-            [__cachedDateFormatters setObject:dateFormatter forKey:format];
-        }
+
+    // the current locale and default time zone are new objects after they have been changed, so the old formatters won't match anymore
+    if (locale == nil) {
+        locale = [NSLocale currentLocale];
+    }
+    if (timeZone == nil) {
+        timeZone = [NSTimeZone defaultTimeZone];
+    }
+
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    INThreadDateFormatterCache *cache = threadDictionary[INThreadDateFormatterCacheKey];
+    if (cache == nil) {
+        cache = [[INThreadDateFormatterCache alloc] init];
+        threadDictionary[INThreadDateFormatterCacheKey] = cache;
     }
-    return dateFormatter;
+    return [cache entryForFormat:format locale:locale timeZone:timeZone];
 }
 
 
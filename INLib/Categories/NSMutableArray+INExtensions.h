@@ -0,0 +1,48 @@
+// NSMutableArray+INExtensions.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+@protocol INRandomSource;
+
+
+@interface NSMutableArray (INExtensions)
+
+
+/**
+ Shuffles the array's elements in place.
+ 
+ Uses the Fisher-Yates algorithm in O(n) on a buffer of the elements with arc4random() for generating random values.
+ */
+- (void)shuffle;
+
+
+/**
+ Shuffles the array's elements in place with random numbers from a source.
+ 
+ Uses the Fisher-Yates algorithm in O(n) on a buffer of the elements, a seeded source like INSeededRandom always returns the same order.
+ 
+ @param source The source of the random numbers or nil for arc4random().
+ */
+- (void)shuffleUsingRandomSource:(id<INRandomSource>)source;
+
+
+@end
@@ -0,0 +1,50 @@
+// NSMutableArray+INExtensions.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "NSMutableArray+INExtensions.h"
+#import "INRandom.h"
+
+
+@implementation NSMutableArray (INExtensions)
+
+- (void)shuffle {
+    [self shuffleUsingRandomSource:nil];
+}
+
+- (void)shuffleUsingRandomSource:(id<INRandomSource>)source {
+    NSUInteger count = self.count;
+    if (count < 2) {
+        return;
+    }
+
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    [self getObjects:objects range:NSMakeRange(0, count)];
+    [INRandom shuffleObjects:objects count:count withRandomSource:source];
+    // the shuffled array retains the objects before the receiver releases them
+    NSArray *shuffledArray = [[NSArray alloc] initWithObjects:objects count:count];
+    free(objects);
+    [self setArray:shuffledArray];
+}
+
+
+@end
@@ -39,8 +39,9 @@
  
  Any spaces and new lines from the start and the ending of the string will be removed.
  Whitspace characters are U000A - U000D and U0085.
+ The characters are scanned in place, so only trimmed strings are copied and an immutable string without whitespaces at its ends is returned itself.
 
- @return A new trimmed string.
+ @return A trimmed string.
  */
 - (NSString *)stringTrimmed;
 
@@ -61,6 +62,7 @@
 
  A string only with whitespaces, tabs and new lines is treated as empty.
  See `[NSCharacterSet whitespaceAndNewlineCharacterSet]` for an exact definition of whitespaces.
+ The characters are scanned in place until the first non whitespace character without creating a trimmed copy.
 
  With this method it is not necessary to check for nil, because calling the method on nil returns false,
  the same when there is no text in this string.
@@ -73,12 +75,25 @@
 /**
  Compares the receiver string with another string case insensitive.
  
+ ASCII strings are compared 16 bytes at a time without creating any objects, all other strings are compared like `compare:options:` with `NSCaseInsensitiveSearch`.
+ 
  @param string The other string to compare with.
  @return True if the two strings are case insensitive equal, otherwise false.
  */
 - (BOOL)isEqualToCaseInsensitiveString:(NSString *)string;
 
 
+/**
+ Checks if the receiver string starts with a given string, ignoring the case.
+ 
+ Uses the same ASCII fast path as isEqualToCaseInsensitiveString:, other strings are searched like `rangeOfString:options:` with `NSCaseInsensitiveSearch` and `NSAnchoredSearch`.
+ 
+ @param prefix The string to search at the beginning of the receiver.
+ @return True if the receiver starts with the prefix, always true for an empty prefix, false if the prefix is nil.
+ */
+- (BOOL)hasCaseInsensitivePrefix:(NSString *)prefix;
+
+
 /**
  Checks if this string starts with a given character.
  
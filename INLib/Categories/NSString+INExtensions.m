@@ -22,6 +22,157 @@
 
 
 #import "NSString+INExtensions.h"
+#import "INVersion.h"
+
+
+// the whitespaces and new lines of the ASCII range as bitmap, the same characters as in whitespaceAndNewlineCharacterSet: 0x09 - 0x0D and 0x20
+static const uint64_t INStringASCIIWhitespaces[2] = {0x100003E00ULL, 0};
+
+// True if the character is in whitespaceAndNewlineCharacterSet, only characters beyond ASCII are looked up in the set.
+static inline BOOL INStringIsWhitespace(UniChar character, CFCharacterSetRef whitespaces) {
+    if (character < 128) {
+        return (INStringASCIIWhitespaces[character >> 6] >> (character & 63)) & 1;
+    }
+    return CFCharacterSetIsCharacterMember(whitespaces, character);
+}
+
+// Returns the range of a string without leading and trailing whitespaces and new lines, the characters are read in place without copying the string.
+static CFRange INStringTrimmedRange(CFStringRef string) {
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    CFCharacterSetRef whitespaces = CFCharacterSetGetPredefined(kCFCharacterSetWhitespaceAndNewline);
+    CFIndex start = 0;
+    while (start < length && INStringIsWhitespace(CFStringGetCharacterFromInlineBuffer(&buffer, start), whitespaces)) {
+        start++;
+    }
+    CFIndex end = length;
+    while (end > start && INStringIsWhitespace(CFStringGetCharacterFromInlineBuffer(&buffer, end - 1), whitespaces)) {
+        end--;
+    }
+    return CFRangeMake(start, end - start);
+}
+
+// Compares two version strings, parses them once when possible and compares the padded strings numerically otherwise.
+static NSComparisonResult INStringVersionCompare(NSString *versionNumber, NSString *otherVersionNumber) {
+    INVersion version, otherVersion;
+    if (INVersionParseString(versionNumber, &version) && INVersionParseString(otherVersionNumber, &otherVersion)) {
+        return INVersionCompare(version, otherVersion);
+    }
+    NSInteger numberOfComponentsString1 = [versionNumber componentsSeparatedByString:@"."].count;
+    NSInteger numberOfComponentsString2 = [otherVersionNumber componentsSeparatedByString:@"."].count;
+    NSString *string1 = [versionNumber versionStringWithLength:numberOfComponentsString2];
+    NSString *string2 = [otherVersionNumber versionStringWithLength:numberOfComponentsString1];
+    return [string1 compare:string2 options:NSNumericSearch];
+}
+
+
+// 16 bytes processed at once, the vectors are mapped to SSE or NEON registers by the compiler
+typedef uint8_t INStringVector __attribute__((vector_size(16)));
+
+#define INStringVectorSplat(byte) ((INStringVector){byte, byte, byte, byte, byte, byte, byte, byte, byte, byte, byte, byte, byte, byte, byte, byte})
+
+// the result of comparing ASCII bytes
+typedef NS_ENUM(NSInteger, INStringASCIIComparison) {
+    INStringASCIIComparisonEqual,
+    INStringASCIIComparisonDifferent,
+    // a non ASCII character has been found before any difference, the strings need a full unicode comparison
+    INStringASCIIComparisonNotASCII,
+};
+
+static inline INStringVector INStringVectorLoad(const uint8_t *bytes) {
+    INStringVector vector;
+    memcpy(&vector, bytes, sizeof(vector));
+    return vector;
+}
+
+static inline BOOL INStringVectorIsZero(INStringVector vector) {
+    uint64_t words[2];
+    memcpy(words, &vector, sizeof(words));
+    return (words[0] | words[1]) == 0;
+}
+
+// Converts the upper case letters A-Z to lower case, all other bytes are unchanged.
+static inline INStringVector INStringVectorFoldCase(INStringVector vector) {
+    INStringVector isUpperCase = (INStringVector)((INStringVector)(vector - INStringVectorSplat('A')) < INStringVectorSplat(26));
+    return vector | (isUpperCase & INStringVectorSplat(0x20));
+}
+
+static inline uint8_t INStringFoldCase(uint8_t byte) {
+    return (uint8_t)(byte - 'A') < 26 ? byte | 0x20 : byte;
+}
+
+// Compares two ASCII byte sequences of the same length case insensitive, 32 or 16 bytes at a time.
+static INStringASCIIComparison INStringCompareASCII(const uint8_t *bytes, const uint8_t *otherBytes, size_t length) {
+    size_t index = 0;
+    for (; index + 32 <= length; index += 32) {
+        INStringVector first = INStringVectorLoad(bytes + index);
+        INStringVector second = INStringVectorLoad(bytes + index + 16);
+        INStringVector otherFirst = INStringVectorLoad(otherBytes + index);
+        INStringVector otherSecond = INStringVectorLoad(otherBytes + index + 16);
+        if (!INStringVectorIsZero((first | second | otherFirst | otherSecond) & INStringVectorSplat(0x80))) {
+            return INStringASCIIComparisonNotASCII;
+        }
+        INStringVector difference = (INStringVectorFoldCase(first) ^ INStringVectorFoldCase(otherFirst)) | (INStringVectorFoldCase(second) ^ INStringVectorFoldCase(otherSecond));
+        if (!INStringVectorIsZero(difference)) {
+            return INStringASCIIComparisonDifferent;
+        }
+    }
+    for (; index + 16 <= length; index += 16) {
+        INStringVector vector = INStringVectorLoad(bytes + index);
+        INStringVector otherVector = INStringVectorLoad(otherBytes + index);
+        if (!INStringVectorIsZero((vector | otherVector) & INStringVectorSplat(0x80))) {
+            return INStringASCIIComparisonNotASCII;
+        }
+        if (!INStringVectorIsZero(INStringVectorFoldCase(vector) ^ INStringVectorFoldCase(otherVector))) {
+            return INStringASCIIComparisonDifferent;
+        }
+    }
+    INStringASCIIComparison result = INStringASCIIComparisonEqual;
+    for (; index < length; index++) {
+        if ((bytes[index] | otherBytes[index]) & 0x80) {
+            return INStringASCIIComparisonNotASCII;
+        }
+        if (INStringFoldCase(bytes[index]) != INStringFoldCase(otherBytes[index])) {
+            result = INStringASCIIComparisonDifferent;
+        }
+    }
+    return result;
+}
+
+// True if all bytes are ASCII characters.
+static BOOL INStringIsASCII(const uint8_t *bytes, size_t length) {
+    size_t index = 0;
+    for (; index + 16 <= length; index += 16) {
+        if (!INStringVectorIsZero(INStringVectorLoad(bytes + index) & INStringVectorSplat(0x80))) {
+            return NO;
+        }
+    }
+    for (; index < length; index++) {
+        if (bytes[index] & 0x80) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+// Returns the first length characters of a string as 8 bit bytes, either in place or copied into the buffer.
+// Returns NULL when the characters have to be compared by Foundation, because they aren't ASCII or are too many for the buffer.
+// Bytes returned in place may still have non ASCII characters, which have to be checked by the caller.
+static inline const uint8_t *INStringASCIIBytes(CFStringRef string, CFIndex length, uint8_t *buffer, CFIndex bufferSize) {
+    const char *characters = CFStringGetCStringPtr(string, kCFStringEncodingASCII);
+    if (characters != NULL) {
+        return (const uint8_t *)characters;
+    }
+    if (length > bufferSize) {
+        return NULL;
+    }
+    CFIndex convertedLength = CFStringGetBytes(string, CFRangeMake(0, length), kCFStringEncodingASCII, 0, false, buffer, bufferSize, NULL);
+    return convertedLength == length ? buffer : NULL;
+}
+
+// the size of the buffers on the stack for strings which can't be read in place
+#define INStringASCIIBufferSize 256
 
 
 @implementation NSString (INExtensions)
@@ -34,83 +185,118 @@
 }
 
 - (NSString *)stringTrimmed {
-	return [self stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    CFRange range = INStringTrimmedRange((__bridge CFStringRef)self);
+    if (range.length == (CFIndex)self.length) {
+        // copying an immutable string returns the same string
+        return [self copy];
+    }
+    return [self substringWithRange:NSMakeRange((NSUInteger)range.location, (NSUInteger)range.length)];
 }
 
 - (BOOL)hasText {
-    return [[self stringTrimmed] length] > 0;
+    CFStringRef string = (__bridge CFStringRef)self;
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    CFCharacterSetRef whitespaces = CFCharacterSetGetPredefined(kCFCharacterSetWhitespaceAndNewline);
+    for (CFIndex index = 0; index < length; index++) {
+        if (!INStringIsWhitespace(CFStringGetCharacterFromInlineBuffer(&buffer, index), whitespaces)) {
+            return YES;
+        }
+    }
+    return NO;
 }
 
 - (BOOL)isEqualToCaseInsensitiveString:(NSString *)string {
     if (string == nil) return NO;
+
+    CFStringRef cfString = (__bridge CFStringRef)self;
+    CFStringRef cfOtherString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    CFIndex otherLength = CFStringGetLength(cfOtherString);
+    uint8_t buffer[INStringASCIIBufferSize];
+    uint8_t otherBuffer[INStringASCIIBufferSize];
+    const uint8_t *bytes = INStringASCIIBytes(cfString, length, buffer, sizeof(buffer));
+    const uint8_t *otherBytes = bytes != NULL ? INStringASCIIBytes(cfOtherString, otherLength, otherBuffer, sizeof(otherBuffer)) : NULL;
+    if (bytes != NULL && otherBytes != NULL) {
+        if (length != otherLength) {
+            // only pure ASCII strings can't be equal with different lengths, unicode folding may change the length
+            if (INStringIsASCII(bytes, (size_t)length) && INStringIsASCII(otherBytes, (size_t)otherLength)) {
+                return NO;
+            }
+        } else {
+            INStringASCIIComparison comparison = INStringCompareASCII(bytes, otherBytes, (size_t)length);
+            if (comparison != INStringASCIIComparisonNotASCII) {
+                return comparison == INStringASCIIComparisonEqual;
+            }
+        }
+    }
+
     NSComparisonResult result = [self compare:string options:NSCaseInsensitiveSearch];
     return result == NSOrderedSame;
 }
 
+- (BOOL)hasCaseInsensitivePrefix:(NSString *)prefix {
+    if (prefix == nil) return NO;
+
+    CFStringRef cfString = (__bridge CFStringRef)self;
+    CFStringRef cfPrefix = (__bridge CFStringRef)prefix;
+    CFIndex length = CFStringGetLength(cfString);
+    CFIndex prefixLength = CFStringGetLength(cfPrefix);
+    if (prefixLength == 0) {
+        return YES;
+    }
+    // the character behind the prefix is compared, too, it must not be a combining character
+    CFIndex comparedLength = MIN(length, prefixLength + 1);
+    uint8_t buffer[INStringASCIIBufferSize];
+    uint8_t prefixBuffer[INStringASCIIBufferSize];
+    const uint8_t *bytes = INStringASCIIBytes(cfString, comparedLength, buffer, sizeof(buffer));
+    const uint8_t *prefixBytes = bytes != NULL ? INStringASCIIBytes(cfPrefix, prefixLength, prefixBuffer, sizeof(prefixBuffer)) : NULL;
+    if (bytes != NULL && prefixBytes != NULL && INStringIsASCII(bytes, (size_t)comparedLength) && INStringIsASCII(prefixBytes, (size_t)prefixLength)) {
+        if (length < prefixLength) {
+            return NO;
+        }
+        return INStringCompareASCII(bytes, prefixBytes, (size_t)prefixLength) == INStringASCIIComparisonEqual;
+    }
+
+    return [self rangeOfString:prefix options:NSCaseInsensitiveSearch | NSAnchoredSearch].location != NSNotFound;
+}
+
 - (NSString *)firstCharacter {
 	if ([self length] == 0) return @"";
 	return [self substringToIndex:1];
 }
 
 - (BOOL)firstCharacterEquals:(NSString *)otherString {
-	NSString *char1 = [self firstCharacter];
-	NSString *char2 = [otherString firstCharacter];
-	return [char1 isEqualToString:char2];
+    if (otherString == nil) return NO;
+
+    // compare the first characters in place instead of creating substrings
+    CFIndex length = CFStringGetLength((__bridge CFStringRef)self);
+    CFIndex otherLength = CFStringGetLength((__bridge CFStringRef)otherString);
+    if (length == 0 || otherLength == 0) {
+        return length == otherLength;
+    }
+    return CFStringGetCharacterAtIndex((__bridge CFStringRef)self, 0) == CFStringGetCharacterAtIndex((__bridge CFStringRef)otherString, 0);
 }
 
 - (BOOL)versionAtLeast:(NSString *)versionNumber {
-    NSInteger numberOfComponentsString1 = [self componentsSeparatedByString:@"."].count;
-    NSInteger numberOfComponentsString2 = [versionNumber componentsSeparatedByString:@"."].count;
-    NSString *string1 = [self versionStringWithLength:numberOfComponentsString2];
-    NSString *string2 = [versionNumber versionStringWithLength:numberOfComponentsString1];
-	if ([string1 compare:string2 options:NSNumericSearch] == NSOrderedAscending) {
-		return NO;
-	}
-	return YES;
+    return INStringVersionCompare(self, versionNumber) != NSOrderedAscending;
 }
 
 - (BOOL)versionAtMost:(NSString *)versionNumber {
-    NSInteger numberOfComponentsString1 = [self componentsSeparatedByString:@"."].count;
-    NSInteger numberOfComponentsString2 = [versionNumber componentsSeparatedByString:@"."].count;
-    NSString *string1 = [self versionStringWithLength:numberOfComponentsString2];
-    NSString *string2 = [versionNumber versionStringWithLength:numberOfComponentsString1];
-	if ([string1 compare:string2 options:NSNumericSearch] == NSOrderedDescending) {
-		return NO;
-	}
-	return YES;
+    return INStringVersionCompare(self, versionNumber) != NSOrderedDescending;
 }
 
 - (BOOL)versionEqualTo:(NSString *)versionNumber {
-    NSInteger numberOfComponentsString1 = [self componentsSeparatedByString:@"."].count;
-    NSInteger numberOfComponentsString2 = [versionNumber componentsSeparatedByString:@"."].count;
-    NSString *string1 = [self versionStringWithLength:numberOfComponentsString2];
-    NSString *string2 = [versionNumber versionStringWithLength:numberOfComponentsString1];
-	if ([string1 compare:string2 options:NSNumericSearch] == NSOrderedSame) {
-		return YES;
-	}
-	return NO;
+    return INStringVersionCompare(self, versionNumber) == NSOrderedSame;
 }
 
 - (BOOL)versionLowerThan:(NSString *)versionNumber {
-    NSInteger numberOfComponentsString1 = [self componentsSeparatedByString:@"."].count;
-    NSInteger numberOfComponentsString2 = [versionNumber componentsSeparatedByString:@"."].count;
-    NSString *string1 = [self versionStringWithLength:numberOfComponentsString2];
-    NSString *string2 = [versionNumber versionStringWithLength:numberOfComponentsString1];
-	if ([string1 compare:string2 options:NSNumericSearch] == NSOrderedAscending) {
-		return YES;
-	}
-	return NO;
+    return INStringVersionCompare(self, versionNumber) == NSOrderedAscending;
 }
 
 - (BOOL)versionHigherThan:(NSString *)versionNumber {
-    NSInteger numberOfComponentsString1 = [self componentsSeparatedByString:@"."].count;
-    NSInteger numberOfComponentsString2 = [versionNumber componentsSeparatedByString:@"."].count;
-    NSString *string1 = [self versionStringWithLength:numberOfComponentsString2];
-    NSString *string2 = [versionNumber versionStringWithLength:numberOfComponentsString1];
-	if ([string1 compare:string2 options:NSNumericSearch] == NSOrderedDescending) {
-		return YES;
-	}
-	return NO;
+    return INStringVersionCompare(self, versionNumber) == NSOrderedDescending;
 }
 
 - (NSString *)versionStringIncreasedAtIndex:(NSUInteger)index {
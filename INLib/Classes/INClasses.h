@@ -29,5 +29,9 @@
 #import "INNavigationController.h"
 #import "INRandom.h"
 #import "INScrollView.h"
+#import "INStringIndex.h"
 #import "INTableView.h"
+#import "INTimeZoneTable.h"
+#import "INVersionConstraint.h"
+#import "INWeightedSampler.h"
 #import "INWindow.h"
@@ -27,6 +27,23 @@
 static NSUInteger const INRandomMaxValue = 0xFFFFFFFFu;
 
 
+/**
+ A source of random numbers which can be passed to the methods using randomness instead of arc4random(), i.e. for reproducible results in tests.
+ 
+ @see INSeededRandom
+ */
+@protocol INRandomSource <NSObject>
+
+/**
+ Returns 32 uniformly distributed random bits.
+ 
+ @return A random 32 bit unsigned integer.
+ */
+- (uint32_t)randomInteger;
+
+@end
+
+
 /**
  A class which returns all kinds of randomness.
  
@@ -101,4 +118,71 @@ static NSUInteger const INRandomMaxValue = 0xFFFFFFFFu;
 + (NSInteger)sign;
 
 
+#pragma mark - Random sources
+/// @name Random sources
+
+/**
+ Returns a uniformly distributed random integer below a bound from a random source.
+ 
+ Other than `random() % upperBound` the result has no modulo bias.
+ 
+ @param upperBound The exclusive upper bound, has to be greater than 0.
+ @param source The source of the random numbers or nil for arc4random().
+ @return A random integer within [0..upperBound).
+ */
++ (NSUInteger)integerBelow:(NSUInteger)upperBound withRandomSource:(id<INRandomSource>)source;
+
+
+/**
+ Shuffles a buffer of objects in place with the Fisher-Yates algorithm in O(count).
+ 
+ All permutations are equally likely if the source is uniformly distributed.
+ 
+ @param objects The buffer of objects to shuffle.
+ @param count The number of objects in the buffer.
+ @param source The source of the random numbers or nil for arc4random().
+ */
++ (void)shuffleObjects:(__unsafe_unretained id *)objects count:(NSUInteger)count withRandomSource:(id<INRandomSource>)source;
+
+
+@end
+
+
+/**
+ A seedable random source, which returns the same sequence of numbers for the same seed.
+ 
+ The numbers are generated with the PCG32 algorithm, which is fast and statistically good, but not suitable for cryptography.
+ A random source keeps a state and must not be used by more than one thread at the same time.
+ 
+    INSeededRandom *random = [INSeededRandom randomWithSeed:42];
+    NSArray *shuffled = [array arrayWithRandomizedOrderUsingRandomSource:random]; // the same order for each run
+ */
+@interface INSeededRandom : NSObject <INRandomSource>
+
+
+/**
+ The seed the source has been initialized with.
+ */
+@property (nonatomic, assign, readonly) uint64_t seed;
+
+
+/**
+ Creates a random source with a seed.
+ 
+ @param seed The seed of the random numbers.
+ @return A new random source.
+ @see initWithSeed:
+ */
++ (instancetype)randomWithSeed:(uint64_t)seed;
+
+
+/**
+ Initializes a random source with a seed.
+ 
+ @param seed The seed of the random numbers.
+ @return The initialized random source.
+ */
+- (instancetype)initWithSeed:(uint64_t)seed;
+
+
 @end
@@ -23,6 +23,34 @@
 
 #import "INRandom.h"
 
+
+// the multiplier and increment of the PCG32 generator's linear congruential state
+static const uint64_t INSeededRandomMultiplier = 6364136223846793005ULL;
+static const uint64_t INSeededRandomIncrement = 1442695040888963407ULL;
+
+// Returns 32 random bits from the source or from arc4random() if there is no source.
+static inline uint32_t INRandomNext(id<INRandomSource> source) {
+    return source != nil ? [source randomInteger] : arc4random();
+}
+
+// Returns a random integer below a 32 bit bound without modulo bias, see Lemire's "Fast Random Integer Generation in an Interval".
+static uint32_t INRandomNextBelow(id<INRandomSource> source, uint32_t upperBound) {
+    if (source == nil) {
+        return arc4random_uniform(upperBound);
+    }
+    uint64_t product = (uint64_t)[source randomInteger] * upperBound;
+    uint32_t low = (uint32_t)product;
+    if (low < upperBound) {
+        uint32_t threshold = (uint32_t)-upperBound % upperBound;
+        while (low < threshold) {
+            product = (uint64_t)[source randomInteger] * upperBound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+
 @implementation INRandom
 
 + (NSUInteger)integer {
@@ -54,4 +82,64 @@
 }
 
 
+#pragma mark - Random sources
+
++ (NSUInteger)integerBelow:(NSUInteger)upperBound withRandomSource:(id<INRandomSource>)source {
+    if (upperBound <= UINT32_MAX) {
+        return INRandomNextBelow(source, (uint32_t)upperBound);
+    }
+    // bounds above 32 bits on 64 bit devices combine two numbers and reject the values of the incomplete last range
+    uint64_t bound = upperBound;
+    uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    uint64_t value;
+    do {
+        value = ((uint64_t)INRandomNext(source) << 32) | INRandomNext(source);
+    } while (value >= limit);
+    return (NSUInteger)(value % bound);
+}
+
++ (void)shuffleObjects:(__unsafe_unretained id *)objects count:(NSUInteger)count withRandomSource:(id<INRandomSource>)source {
+    for (NSUInteger index = count; index > 1; index--) {
+        NSUInteger otherIndex = index <= UINT32_MAX ? INRandomNextBelow(source, (uint32_t)index) : [self integerBelow:index withRandomSource:source];
+        __unsafe_unretained id object = objects[index - 1];
+        objects[index - 1] = objects[otherIndex];
+        objects[otherIndex] = object;
+    }
+}
+
+
+@end
+
+
+@implementation INSeededRandom {
+    uint64_t _state;
+}
+
++ (instancetype)randomWithSeed:(uint64_t)seed {
+    return [[self alloc] initWithSeed:seed];
+}
+
+- (instancetype)initWithSeed:(uint64_t)seed {
+    self = [super init];
+    if (self == nil) return self;
+
+    _seed = seed;
+    // the seeding of the reference implementation, so the sequences are the same
+    _state = 0;
+    [self randomInteger];
+    _state += seed;
+    [self randomInteger];
+
+    return self;
+}
+
+- (uint32_t)randomInteger {
+    uint64_t state = _state;
+    _state = state * INSeededRandomMultiplier + INSeededRandomIncrement;
+    uint32_t xorShifted = (uint32_t)(((state >> 18) ^ state) >> 27);
+    uint32_t rotation = (uint32_t)(state >> 59);
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+}
+
+
 @end
@@ -0,0 +1,146 @@
+// INStringIndex.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+/**
+ An immutable index over an array of strings for case insensitive lookups and prefix completions.
+ 
+ Searching a name in a large list with `isEqualToCaseInsensitiveString:` compares every string with unicode folding.
+ The index decomposes all strings once like `CFStringNormalize()` with `kCFStringNormalizationFormD` and folds them like `CFStringFold()` with `kCFCompareCaseInsensitive`,
+ so precomposed and decomposed characters like "é" and "e\u0301" are equal as with `NSCaseInsensitiveSearch`.
+ A prefix has to end with a whole character like with `hasCaseInsensitivePrefix:`, so "Ärger" doesn't start with "a".
+ The folded keys are kept sorted in one buffer, so a lookup is a binary search and finding all strings with a prefix costs one more binary search plus the results.
+ 
+ The index is immutable and can be used by many threads at the same time.
+ 
+    INStringIndex *index = [INStringIndex indexWithStrings:@[@"Berlin", @"Bern", @"Bonn"]];
+    NSUInteger position = [index indexOfString:@"BONN"]; // = 2
+    NSArray *completions = [index stringsWithPrefix:@"ber" limit:10]; // = @[@"Berlin", @"Bern"]
+ */
+@interface INStringIndex : NSObject
+
+
+/**
+ The indexed strings in the original order.
+ */
+@property (nonatomic, copy, readonly) NSArray *strings;
+
+
+/**
+ Creates an index over an array of strings.
+ 
+ @param strings The strings to index, may contain duplicates.
+ @return A new index.
+ @see initWithStrings:
+ */
++ (instancetype)indexWithStrings:(NSArray *)strings;
+
+
+/**
+ Initializes an index over an array of strings.
+ 
+ The strings are folded and sorted once, which takes O(n log n) for n strings.
+ 
+ @param strings The strings to index, may contain duplicates.
+ @return The initialized index.
+ */
+- (instancetype)initWithStrings:(NSArray *)strings;
+
+
+#pragma mark - Exact lookups
+/// @name Exact lookups
+
+/**
+ Returns the index of a string which is case insensitive equal to the given string.
+ 
+ @param string The string to look up.
+ @return The lowest index in strings of an equal string or NSNotFound if there is none.
+ */
+- (NSUInteger)indexOfString:(NSString *)string;
+
+
+/**
+ True if the index contains a string which is case insensitive equal to the given string.
+ 
+ @param string The string to look up.
+ @return True if an equal string exists.
+ */
+- (BOOL)containsString:(NSString *)string;
+
+
+/**
+ Returns the indexes of all strings which are case insensitive equal to the given string.
+ 
+ @param string The string to look up.
+ @return The indexes in strings of the equal strings.
+ */
+- (NSIndexSet *)indexesOfString:(NSString *)string;
+
+
+#pragma mark - Prefix lookups
+/// @name Prefix lookups
+
+/**
+ Returns the number of strings starting case insensitive with a prefix.
+ 
+ @param prefix The prefix to search, an empty prefix matches all strings.
+ @return The number of matching strings.
+ */
+- (NSUInteger)countOfStringsWithPrefix:(NSString *)prefix;
+
+
+/**
+ Returns the indexes of all strings starting case insensitive with a prefix.
+ 
+ @param prefix The prefix to search, an empty prefix matches all strings.
+ @return The indexes in strings of the matching strings.
+ */
+- (NSIndexSet *)indexesOfStringsWithPrefix:(NSString *)prefix;
+
+
+/**
+ Enumerates all strings starting case insensitive with a prefix.
+ 
+ The strings are enumerated in the lexicographic order of their folded keys' UTF-16 characters, not by their length, so "Berlin" comes before "Bern".
+ Strings with equal keys are enumerated in their original order.
+ 
+ @param prefix The prefix to search, an empty prefix matches all strings.
+ @param block The block called with each matching string and its index in strings, set stop to true to finish the enumeration.
+ */
+- (void)enumerateStringsWithPrefix:(NSString *)prefix usingBlock:(void (^)(NSString *string, NSUInteger index, BOOL *stop))block;
+
+
+/**
+ Returns the first strings starting case insensitive with a prefix for completing an input.
+ 
+ The strings are the first limit ones in the order of enumerateStringsWithPrefix:usingBlock:, which is the lexicographic order of the folded keys.
+ So they aren't necessarily the shortest or best completions, i.e. with a limit of 1 the prefix "ber" returns "Berlin" and not "Bern".
+ Only the returned strings are visited.
+ 
+ @param prefix The prefix to search, an empty prefix matches all strings.
+ @param limit The maximum number of strings to return.
+ @return An array with up to limit strings.
+ */
+- (NSArray *)stringsWithPrefix:(NSString *)prefix limit:(NSUInteger)limit;
+
+
+@end
@@ -0,0 +1,287 @@
+// INStringIndex.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "INStringIndex.h"
+
+
+// the number of characters of a searched string which are folded on the stack
+#define INStringIndexSearchBufferSize 128
+
+// Writes the canonically decomposed and case folded characters of a string into the buffer if they fit and returns the number of folded characters.
+static NSUInteger INStringIndexFold(CFStringRef string, UniChar *buffer, NSUInteger capacity) {
+    CFIndex length = CFStringGetLength(string);
+    if ((NSUInteger)length <= capacity) {
+        CFStringGetCharacters(string, CFRangeMake(0, length), buffer);
+        BOOL isASCII = YES;
+        for (CFIndex index = 0; index < length; index++) {
+            UniChar character = buffer[index];
+            if (character >= 0x80) {
+                isASCII = NO;
+                break;
+            }
+            if ((UniChar)(character - 'A') < 26) {
+                buffer[index] = character | 0x20;
+            }
+        }
+        if (isASCII) {
+            return (NSUInteger)length;
+        }
+    }
+
+    // other characters may change the length when folded, i.e. ß becomes ss,
+    // they are decomposed first, so precomposed and decomposed characters get the same key like with NSCaseInsensitiveSearch
+    CFMutableStringRef folded = CFStringCreateMutableCopy(kCFAllocatorDefault, 0, string);
+    CFStringNormalize(folded, kCFStringNormalizationFormD);
+    CFStringFold(folded, kCFCompareCaseInsensitive, NULL);
+    CFIndex foldedLength = CFStringGetLength(folded);
+    if ((NSUInteger)foldedLength <= capacity) {
+        CFStringGetCharacters(folded, CFRangeMake(0, foldedLength), buffer);
+    }
+    CFRelease(folded);
+    return (NSUInteger)foldedLength;
+}
+
+// Compares a folded key with the searched characters, with prefix set all keys starting with the characters are the same.
+static inline int INStringIndexCompare(const UniChar *key, NSUInteger keyLength, const UniChar *search, NSUInteger searchLength, BOOL prefix) {
+    NSUInteger length = MIN(keyLength, searchLength);
+    for (NSUInteger index = 0; index < length; index++) {
+        if (key[index] != search[index]) {
+            return key[index] < search[index] ? -1 : 1;
+        }
+    }
+    if (keyLength == searchLength || (prefix && keyLength > searchLength)) {
+        return 0;
+    }
+    return keyLength < searchLength ? -1 : 1;
+}
+
+
+@implementation INStringIndex {
+    // the folded keys of all strings one after another
+    UniChar *_characters;
+    // the start of each string's key in the characters in the original order, plus the end of the last key
+    NSUInteger *_offsets;
+    // the indexes of the strings sorted by their keys, equal keys in the original order
+    NSUInteger *_sortedIndexes;
+    NSUInteger _count;
+}
+
++ (instancetype)indexWithStrings:(NSArray *)strings {
+    return [[self alloc] initWithStrings:strings];
+}
+
+- (instancetype)initWithStrings:(NSArray *)strings {
+    self = [super init];
+    if (self == nil) return self;
+    
+    _strings = strings != nil ? [strings copy] : @[];
+    _count = _strings.count;
+    _offsets = malloc((_count + 1) * sizeof(NSUInteger));
+    _sortedIndexes = malloc(MAX(_count, 1) * sizeof(NSUInteger));
+
+    // fold all strings into one growing buffer
+    NSUInteger capacity = 16 * _count + 16;
+    NSUInteger length = 0;
+    _characters = malloc(capacity * sizeof(UniChar));
+    for (NSUInteger index = 0; index < _count; index++) {
+        CFStringRef string = (__bridge CFStringRef)_strings[index];
+        NSUInteger stringLength = (NSUInteger)CFStringGetLength(string);
+        if (length + stringLength > capacity) {
+            capacity = MAX(2 * capacity, length + stringLength);
+            _characters = realloc(_characters, capacity * sizeof(UniChar));
+        }
+        NSUInteger foldedLength = INStringIndexFold(string, _characters + length, capacity - length);
+        if (length + foldedLength > capacity) {
+            capacity = MAX(2 * capacity, length + foldedLength);
+            _characters = realloc(_characters, capacity * sizeof(UniChar));
+            INStringIndexFold(string, _characters + length, capacity - length);
+        }
+        _offsets[index] = length;
+        _sortedIndexes[index] = index;
+        length += foldedLength;
+    }
+    _offsets[_count] = length;
+
+    const UniChar *characters = _characters;
+    const NSUInteger *offsets = _offsets;
+    qsort_b(_sortedIndexes, _count, sizeof(NSUInteger), ^int(const void *first, const void *second) {
+        NSUInteger firstIndex = *(const NSUInteger *)first;
+        NSUInteger secondIndex = *(const NSUInteger *)second;
+        int result = INStringIndexCompare(characters + offsets[firstIndex], offsets[firstIndex + 1] - offsets[firstIndex],
+                                          characters + offsets[secondIndex], offsets[secondIndex + 1] - offsets[secondIndex], NO);
+        if (result != 0) {
+            return result;
+        }
+        return firstIndex < secondIndex ? -1 : 1;
+    });
+    
+    return self;
+}
+
+- (void)dealloc {
+    free(_characters);
+    free(_offsets);
+    free(_sortedIndexes);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p, %lu strings>", NSStringFromClass([self class]), self, (unsigned long)_count];
+}
+
+// Returns the range within the sorted indexes of all keys equal to the folded string or, with prefix set, starting with it.
+// The folded length of the string is returned in searchLengthPointer if not NULL.
+- (NSRange)sortedRangeOfString:(NSString *)string prefix:(BOOL)prefix searchLength:(NSUInteger *)searchLengthPointer {
+    if (string == nil) {
+        return NSMakeRange(0, 0);
+    }
+
+    UniChar buffer[INStringIndexSearchBufferSize];
+    UniChar *search = buffer;
+    NSUInteger searchLength = INStringIndexFold((__bridge CFStringRef)string, buffer, INStringIndexSearchBufferSize);
+    if (searchLengthPointer != NULL) {
+        *searchLengthPointer = searchLength;
+    }
+    if (searchLength > INStringIndexSearchBufferSize) {
+        search = malloc(searchLength * sizeof(UniChar));
+        INStringIndexFold((__bridge CFStringRef)string, search, searchLength);
+    }
+
+    // the first key not lower than the string
+    NSUInteger low = 0;
+    NSUInteger high = _count;
+    while (low < high) {
+        NSUInteger middle = (low + high) / 2;
+        NSUInteger index = _sortedIndexes[middle];
+        if (INStringIndexCompare(_characters + _offsets[index], _offsets[index + 1] - _offsets[index], search, searchLength, prefix) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    NSUInteger location = low;
+
+    // the first key higher than the string
+    high = _count;
+    while (low < high) {
+        NSUInteger middle = (low + high) / 2;
+        NSUInteger index = _sortedIndexes[middle];
+        if (INStringIndexCompare(_characters + _offsets[index], _offsets[index + 1] - _offsets[index], search, searchLength, prefix) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (search != buffer) {
+        free(search);
+    }
+    return NSMakeRange(location, low - location);
+}
+
+// True if the key at the sorted position continues the character ending at the prefix length with a combining mark,
+// so the string doesn't start with the prefix, i.e. "A\u0308" doesn't start with "a".
+- (BOOL)keyAtSortedPosition:(NSUInteger)position continuesCharacterAtLength:(NSUInteger)prefixLength {
+    NSUInteger index = _sortedIndexes[position];
+    if (prefixLength == 0 || _offsets[index + 1] - _offsets[index] <= prefixLength) {
+        return NO;
+    }
+    UniChar character = _characters[_offsets[index] + prefixLength];
+    return character >= 0x300 && CFCharacterSetIsCharacterMember(CFCharacterSetGetPredefined(kCFCharacterSetNonBase), character);
+}
+
+// Returns the indexes of the strings within a range of the sorted indexes.
+- (NSIndexSet *)indexesInSortedRange:(NSRange)range {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    for (NSUInteger position = range.location; position < NSMaxRange(range); position++) {
+        [indexes addIndex:_sortedIndexes[position]];
+    }
+    return indexes;
+}
+
+
+#pragma mark - Exact lookups
+
+- (NSUInteger)indexOfString:(NSString *)string {
+    NSRange range = [self sortedRangeOfString:string prefix:NO searchLength:NULL];
+    // equal keys are sorted by their original index
+    return range.length > 0 ? _sortedIndexes[range.location] : NSNotFound;
+}
+
+- (BOOL)containsString:(NSString *)string {
+    return [self sortedRangeOfString:string prefix:NO searchLength:NULL].length > 0;
+}
+
+- (NSIndexSet *)indexesOfString:(NSString *)string {
+    return [self indexesInSortedRange:[self sortedRangeOfString:string prefix:NO searchLength:NULL]];
+}
+
+
+#pragma mark - Prefix lookups
+
+- (NSUInteger)countOfStringsWithPrefix:(NSString *)prefix {
+    NSUInteger prefixLength = 0;
+    NSRange range = [self sortedRangeOfString:prefix prefix:YES searchLength:&prefixLength];
+    NSUInteger count = 0;
+    for (NSUInteger position = range.location; position < NSMaxRange(range); position++) {
+        if (![self keyAtSortedPosition:position continuesCharacterAtLength:prefixLength]) {
+            count++;
+        }
+    }
+    return count;
+}
+
+- (NSIndexSet *)indexesOfStringsWithPrefix:(NSString *)prefix {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    [self enumerateStringsWithPrefix:prefix usingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+        [indexes addIndex:index];
+    }];
+    return indexes;
+}
+
+- (void)enumerateStringsWithPrefix:(NSString *)prefix usingBlock:(void (^)(NSString *string, NSUInteger index, BOOL *stop))block {
+    NSUInteger prefixLength = 0;
+    NSRange range = [self sortedRangeOfString:prefix prefix:YES searchLength:&prefixLength];
+    BOOL stop = NO;
+    for (NSUInteger position = range.location; position < NSMaxRange(range) && !stop; position++) {
+        if ([self keyAtSortedPosition:position continuesCharacterAtLength:prefixLength]) {
+            continue;
+        }
+        NSUInteger index = _sortedIndexes[position];
+        block(_strings[index], index, &stop);
+    }
+}
+
+- (NSArray *)stringsWithPrefix:(NSString *)prefix limit:(NSUInteger)limit {
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:MIN(limit, (NSUInteger)16)];
+    if (limit == 0) {
+        return strings;
+    }
+    [self enumerateStringsWithPrefix:prefix usingBlock:^(NSString *string, NSUInteger index, BOOL *stop) {
+        [strings addObject:string];
+        *stop = strings.count == limit;
+    }];
+    return strings;
+}
+
+
+@end
@@ -0,0 +1,98 @@
+// INTimeZoneTable.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+/**
+ A precompiled table of a time zone's offset transitions within a range of years.
+ 
+ Looking up a time zone's offset from GMT with NSTimeZone or NSCalendar is slow when done for many dates, i.e. when converting historic data across daylight saving time changes.
+ This table collects all transitions of a time zone once, so an offset can be looked up with a binary search.
+ Times outside of the table's range fall back to the time zone itself, so the results are always the same as NSTimeZone's results.
+ 
+ A table is immutable and can be used by many threads at the same time.
+ Pass it to the NSDate extension's methods accepting a time zone table for the fast path.
+ 
+    INTimeZoneTable *table = [INTimeZoneTable tableWithTimeZone:[NSTimeZone timeZoneWithName:@"Europe/Berlin"] fromYear:1970 toYear:2030];
+    INDateInformation info = [date dateInformationWithTimeZoneTable:table];
+ */
+@interface INTimeZoneTable : NSObject
+
+
+/**
+ The time zone this table has been created for.
+ */
+@property (nonatomic, strong, readonly) NSTimeZone *timeZone;
+
+
+/**
+ The number of offset transitions within the table's range.
+ */
+@property (nonatomic, assign, readonly) NSUInteger numberOfTransitions;
+
+
+/**
+ Creates a table for a time zone within the given range of years.
+ 
+ @param timeZone The time zone for which to collect the transitions.
+ @param startYear The first year covered by the table, i.e. 1970.
+ @param endYear The last year covered by the table, has to be equal or greater than the start year.
+ @return A new table or nil if the time zone is nil or the end year is before the start year.
+ @see initWithTimeZone:fromYear:toYear:
+ */
++ (instancetype)tableWithTimeZone:(NSTimeZone *)timeZone fromYear:(NSInteger)startYear toYear:(NSInteger)endYear;
+
+
+/**
+ Initializes a table for a time zone within the given range of years.
+ 
+ @param timeZone The time zone for which to collect the transitions.
+ @param startYear The first year covered by the table, i.e. 1970.
+ @param endYear The last year covered by the table, has to be equal or greater than the start year.
+ @return The initialized table or nil if the time zone is nil or the end year is before the start year.
+ */
+- (instancetype)initWithTimeZone:(NSTimeZone *)timeZone fromYear:(NSInteger)startYear toYear:(NSInteger)endYear;
+
+
+/**
+ Returns the time zone's offset from GMT for a point in time.
+ 
+ The same as calling `[timeZone secondsFromGMTForDate:date]`, but without creating a date object.
+ 
+ @param timeInterval The seconds since the reference date 1st January 2001 GMT.
+ @return The offset in seconds.
+ */
+- (NSInteger)secondsFromGMTForTimeInterval:(NSTimeInterval)timeInterval;
+
+
+/**
+ Returns the point in time for a local time in the table's time zone.
+ 
+ Local times skipped when switching to daylight saving time are moved forward by the length of the gap
+ and local times which occur twice when switching back resolve to the first occurrence, the same as NSCalendar does.
+ 
+ @param localTimeInterval The local time as seconds since the 1st January 2001 00:00:00 in the table's time zone.
+ @return The seconds since the reference date 1st January 2001 GMT.
+ */
+- (NSTimeInterval)timeIntervalForLocalTimeInterval:(NSTimeInterval)localTimeInterval;
+
+
+@end
@@ -0,0 +1,117 @@
+// INTimeZoneTable.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "INTimeZoneTable.h"
+#import "INDateArithmetic.h"
+
+
+// INDateOffsetFunction looking up the offset in a table given as context
+static NSInteger INTimeZoneTableOffsetFunction(const void *context, NSTimeInterval timeInterval) {
+    return [(__bridge INTimeZoneTable *)context secondsFromGMTForTimeInterval:timeInterval];
+}
+
+
+@implementation INTimeZoneTable {
+    // the covered range, the offsets outside of it will be retrieved from the time zone
+    NSTimeInterval _startTimeInterval;
+    NSTimeInterval _endTimeInterval;
+    // sorted points in time when the offset changes
+    NSTimeInterval *_transitions;
+    // the offsets before the first transition and after each transition, so one more than transitions
+    int32_t *_offsets;
+}
+
++ (instancetype)tableWithTimeZone:(NSTimeZone *)timeZone fromYear:(NSInteger)startYear toYear:(NSInteger)endYear {
+    return [[self alloc] initWithTimeZone:timeZone fromYear:startYear toYear:endYear];
+}
+
+- (instancetype)initWithTimeZone:(NSTimeZone *)timeZone fromYear:(NSInteger)startYear toYear:(NSInteger)endYear {
+    if (timeZone == nil || endYear < startYear) {
+        return nil;
+    }
+    self = [super init];
+    if (self == nil) return self;
+    
+    _timeZone = timeZone;
+    // one more day on each side so any local time within the years is covered
+    _startTimeInterval = (INDateDaysFromCivil(startYear, 1, 1) - 1) * (NSTimeInterval)INDateSecondsPerDay - NSTimeIntervalSince1970;
+    _endTimeInterval = (INDateDaysFromCivil(endYear + 1, 1, 1) + 1) * (NSTimeInterval)INDateSecondsPerDay - NSTimeIntervalSince1970;
+
+    // most time zones have at most two transitions per year
+    NSUInteger capacity = 2 * (endYear - startYear + 1);
+    _transitions = malloc(capacity * sizeof(NSTimeInterval));
+    _offsets = malloc((capacity + 1) * sizeof(int32_t));
+    
+    CFTimeZoneRef cfTimeZone = (__bridge CFTimeZoneRef)timeZone;
+    CFAbsoluteTime time = _startTimeInterval;
+    _offsets[0] = (int32_t)CFTimeZoneGetSecondsFromGMT(cfTimeZone, time);
+    while (YES) {
+        CFAbsoluteTime transition = CFTimeZoneGetNextDaylightSavingTimeTransition(cfTimeZone, time);
+        // no more transitions are returned as 0
+        if (transition <= time || transition >= _endTimeInterval) {
+            break;
+        }
+        if (_numberOfTransitions == capacity) {
+            capacity *= 2;
+            _transitions = realloc(_transitions, capacity * sizeof(NSTimeInterval));
+            _offsets = realloc(_offsets, (capacity + 1) * sizeof(int32_t));
+        }
+        _transitions[_numberOfTransitions] = transition;
+        _offsets[_numberOfTransitions + 1] = (int32_t)CFTimeZoneGetSecondsFromGMT(cfTimeZone, transition);
+        _numberOfTransitions++;
+        time = transition;
+    }
+    
+    return self;
+}
+
+- (void)dealloc {
+    free(_transitions);
+    free(_offsets);
+}
+
+- (NSInteger)secondsFromGMTForTimeInterval:(NSTimeInterval)timeInterval {
+    if (!(timeInterval >= _startTimeInterval && timeInterval < _endTimeInterval)) {
+        return (NSInteger)CFTimeZoneGetSecondsFromGMT((__bridge CFTimeZoneRef)_timeZone, timeInterval);
+    }
+    
+    // binary search for the number of transitions up to the time
+    NSUInteger low = 0;
+    NSUInteger high = _numberOfTransitions;
+    while (low < high) {
+        NSUInteger middle = (low + high) / 2;
+        if (_transitions[middle] <= timeInterval) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return _offsets[low];
+}
+
+- (NSTimeInterval)timeIntervalForLocalTimeInterval:(NSTimeInterval)localTimeInterval {
+    return INDateTimeIntervalFromLocalTimeInterval(localTimeInterval, INTimeZoneTableOffsetFunction, (__bridge const void *)self);
+}
+
+
+@end
@@ -0,0 +1,113 @@
+// INVersionConstraint.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "INVersion.h"
+
+
+/**
+ A compiled version constraint like ">=1.2 <2.0 || ~3.1", which matches parsed versions without creating any objects.
+ 
+ A constraint consists of alternative sets separated by "||", a version matches when it matches all terms of any set.
+ The terms of a set are separated by whitespaces and consist of an optional operator and a version:
+ 
+ - `1.2` or `=1.2` matches equal versions, missing components count as 0, so 1.2.0 matches, too
+ - `!=1.2`, `<1.2`, `<=1.2`, `>1.2` and `>=1.2` compare with the version
+ - `~1.2.3` matches from 1.2.3 up to the next minor version 1.3, `~1` up to 2
+ - `^1.2.3` matches from 1.2.3 up to the next increase of the first non zero component, i.e. 2 or for `^0.2.3` 0.3
+ - `1.2.x` or `1.2.*` matches all versions starting with 1.2 and `*` matches any version
+ 
+ The constraint is immutable and can be used by many threads at the same time.
+ 
+    INVersionConstraint *constraint = [INVersionConstraint constraintWithString:@">=1.2 <2.0 || ~3.1"];
+    BOOL matches = [constraint matchesVersionString:@"3.1.4"]; // = YES
+ */
+@interface INVersionConstraint : NSObject
+
+
+/**
+ The expression the constraint has been compiled from.
+ */
+@property (nonatomic, copy, readonly) NSString *expression;
+
+
+/**
+ Compiles a version constraint.
+ 
+ @param expression The constraint's expression.
+ @return The new constraint or nil if the expression is not valid.
+ @see initWithString:
+ */
++ (instancetype)constraintWithString:(NSString *)expression;
+
+
+/**
+ Initializes a version constraint by compiling the expression.
+ 
+ @param expression The constraint's expression.
+ @return The initialized constraint or nil if the expression is not valid.
+ */
+- (instancetype)initWithString:(NSString *)expression;
+
+
+#pragma mark - Matching versions
+/// @name Matching versions
+
+/**
+ True if a parsed version matches the constraint.
+ 
+ @param version The version to check.
+ @return True if the version matches.
+ */
+- (BOOL)matchesVersion:(INVersion)version;
+
+
+/**
+ True if a version string matches the constraint.
+ 
+ @param versionString The version to check, see INVersionParseString() for valid versions.
+ @return True if the string is a valid version and matches, otherwise false.
+ */
+- (BOOL)matchesVersionString:(NSString *)versionString;
+
+
+/**
+ Filters version strings by the constraint.
+ 
+ Each string is parsed only once, objects which are no valid versions are removed.
+ 
+ @param versionStrings The version strings to filter.
+ @return A new array with all strings which match the constraint in the same order.
+ */
+- (NSArray *)filteredVersionStrings:(NSArray *)versionStrings;
+
+
+/**
+ Returns the indexes of all parsed versions which match the constraint.
+ 
+ @param versions The versions to check.
+ @param count The number of versions.
+ @return The indexes of the matching versions.
+ */
+- (NSIndexSet *)indexesOfVersionsMatching:(const INVersion *)versions count:(NSUInteger)count;
+
+
+@end
@@ -0,0 +1,238 @@
+// INVersionConstraint.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "INVersionConstraint.h"
+#import "INVersion.h"
+
+
+// the comparisons of a constraint's terms
+typedef NS_ENUM(uint8_t, INVersionConstraintOperation) {
+    INVersionConstraintOperationEqual,
+    INVersionConstraintOperationNotEqual,
+    INVersionConstraintOperationLower,
+    INVersionConstraintOperationLowerOrEqual,
+    INVersionConstraintOperationHigher,
+    INVersionConstraintOperationHigherOrEqual,
+    // separates the alternative sets of terms
+    INVersionConstraintOperationOr,
+};
+
+// One comparison of a constraint.
+typedef struct INVersionConstraintTerm {
+    INVersionConstraintOperation operation;
+    INVersion version;
+} INVersionConstraintTerm;
+
+// True if the version passes the term's comparison.
+static inline BOOL INVersionConstraintTermMatches(const INVersionConstraintTerm *term, INVersion version) {
+    NSComparisonResult result = INVersionCompare(version, term->version);
+    switch (term->operation) {
+        case INVersionConstraintOperationEqual:
+            return result == NSOrderedSame;
+        case INVersionConstraintOperationNotEqual:
+            return result != NSOrderedSame;
+        case INVersionConstraintOperationLower:
+            return result == NSOrderedAscending;
+        case INVersionConstraintOperationLowerOrEqual:
+            return result != NSOrderedDescending;
+        case INVersionConstraintOperationHigher:
+            return result == NSOrderedDescending;
+        case INVersionConstraintOperationHigherOrEqual:
+            return result != NSOrderedAscending;
+        case INVersionConstraintOperationOr:
+            return YES;
+    }
+    return NO;
+}
+
+
+@implementation INVersionConstraint {
+    NSMutableData *_terms;
+}
+
++ (instancetype)constraintWithString:(NSString *)expression {
+    return [[self alloc] initWithString:expression];
+}
+
+- (instancetype)initWithString:(NSString *)expression {
+    self = [super init];
+    if (self == nil) return self;
+
+    _expression = [expression copy];
+    _terms = [[NSMutableData alloc] init];
+    if (![self compileExpression:_expression]) {
+        return nil;
+    }
+
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p, %@>", NSStringFromClass([self class]), self, self.expression];
+}
+
+- (void)addTermWithOperation:(INVersionConstraintOperation)operation version:(INVersion)version {
+    INVersionConstraintTerm term = {operation, version};
+    [_terms appendBytes:&term length:sizeof(term)];
+}
+
+// Adds the terms for a range from the version up to the version increased at the index.
+- (void)addRangeFromVersion:(INVersion)version increasedAtIndex:(NSUInteger)index {
+    [self addTermWithOperation:INVersionConstraintOperationHigherOrEqual version:version];
+    [self addTermWithOperation:INVersionConstraintOperationLower version:INVersionIncreasedAtIndex(version, index)];
+}
+
+- (BOOL)compileExpression:(NSString *)expression {
+    if (expression == nil) {
+        return NO;
+    }
+    expression = [expression stringByReplacingOccurrencesOfString:@"||" withString:@" || "];
+    NSArray *tokens = [expression componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    NSArray *operators = @[@">=", @"<=", @"!=", @">", @"<", @"=", @"~", @"^"];
+    // a set with * matches all versions and needs no terms, but it isn't empty
+    BOOL setIsEmpty = YES;
+
+    for (NSUInteger index = 0; index < tokens.count; index++) {
+        NSString *token = tokens[index];
+        if (token.length == 0) {
+            continue;
+        }
+        if ([token isEqualToString:@"||"]) {
+            if (setIsEmpty) {
+                return NO;
+            }
+            [self addTermWithOperation:INVersionConstraintOperationOr version:INVersionMake(0, 0, 0)];
+            setIsEmpty = YES;
+            continue;
+        }
+
+        // split the operator from the version, which may also be the next token
+        NSString *operator = @"";
+        for (NSString *candidate in operators) {
+            if ([token hasPrefix:candidate]) {
+                operator = candidate;
+                token = [token substringFromIndex:candidate.length];
+                break;
+            }
+        }
+        if (token.length == 0 && operator.length > 0) {
+            do {
+                index++;
+            } while (index < tokens.count && [tokens[index] length] == 0);
+            if (index >= tokens.count) {
+                return NO;
+            }
+            token = tokens[index];
+        }
+        setIsEmpty = NO;
+
+        // wildcards are only allowed as the last components without any operator but =
+        NSMutableArray *components = [[token componentsSeparatedByString:@"."] mutableCopy];
+        NSUInteger wildcards = 0;
+        while (components.count > 0 && [@[@"x", @"X", @"*"] containsObject:components.lastObject]) {
+            [components removeLastObject];
+            wildcards++;
+        }
+        INVersion version;
+        if (!INVersionParseString([components componentsJoinedByString:@"."], &version)) {
+            return NO;
+        }
+        if (wildcards > 0) {
+            if (operator.length > 0 && ![operator isEqualToString:@"="]) {
+                return NO;
+            }
+            if (version.count > 0) {
+                [self addRangeFromVersion:version increasedAtIndex:version.count - 1];
+            }
+            continue;
+        }
+        if (version.count == 0) {
+            return NO;
+        }
+
+        if ([operator isEqualToString:@"~"]) {
+            [self addRangeFromVersion:version increasedAtIndex:version.count >= 2 ? 1 : 0];
+        } else if ([operator isEqualToString:@"^"]) {
+            NSUInteger firstNonZero = 0;
+            while (firstNonZero < version.count - 1 && version.components[firstNonZero] == 0) {
+                firstNonZero++;
+            }
+            [self addRangeFromVersion:version increasedAtIndex:firstNonZero];
+        } else {
+            NSDictionary *operations = @{@"": @(INVersionConstraintOperationEqual), @"=": @(INVersionConstraintOperationEqual), @"!=": @(INVersionConstraintOperationNotEqual),
+                                         @"<": @(INVersionConstraintOperationLower), @"<=": @(INVersionConstraintOperationLowerOrEqual),
+                                         @">": @(INVersionConstraintOperationHigher), @">=": @(INVersionConstraintOperationHigherOrEqual)};
+            [self addTermWithOperation:(INVersionConstraintOperation)[operations[operator] unsignedCharValue] version:version];
+        }
+    }
+    return !setIsEmpty;
+}
+
+
+#pragma mark - Matching versions
+
+- (BOOL)matchesVersion:(INVersion)version {
+    const INVersionConstraintTerm *terms = _terms.bytes;
+    NSUInteger count = _terms.length / sizeof(INVersionConstraintTerm);
+    BOOL setMatches = YES;
+    for (NSUInteger index = 0; index < count; index++) {
+        const INVersionConstraintTerm *term = &terms[index];
+        if (term->operation == INVersionConstraintOperationOr) {
+            if (setMatches) {
+                return YES;
+            }
+            setMatches = YES;
+        } else if (setMatches) {
+            setMatches = INVersionConstraintTermMatches(term, version);
+        }
+    }
+    return setMatches;
+}
+
+- (BOOL)matchesVersionString:(NSString *)versionString {
+    INVersion version;
+    return INVersionParseString(versionString, &version) && [self matchesVersion:version];
+}
+
+- (NSArray *)filteredVersionStrings:(NSArray *)versionStrings {
+    NSMutableArray *filteredStrings = [[NSMutableArray alloc] init];
+    for (id versionString in versionStrings) {
+        if ([versionString isKindOfClass:[NSString class]] && [self matchesVersionString:versionString]) {
+            [filteredStrings addObject:versionString];
+        }
+    }
+    return filteredStrings;
+}
+
+- (NSIndexSet *)indexesOfVersionsMatching:(const INVersion *)versions count:(NSUInteger)count {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    for (NSUInteger index = 0; index < count; index++) {
+        if ([self matchesVersion:versions[index]]) {
+            [indexes addIndex:index];
+        }
+    }
+    return indexes;
+}
+
+
+@end
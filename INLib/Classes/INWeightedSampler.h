@@ -0,0 +1,138 @@
+// INWeightedSampler.h
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+@protocol INRandomSource;
+
+
+/**
+ Draws random objects with given weights in constant time, i.e. for A/B test allocations or weighted recommendations.
+ 
+ The sampler builds an alias table with Vose's alias method once in O(n), afterwards each draw costs one random index and one random comparison regardless of the number of objects.
+ The random numbers are taken from arc4random() or from an INRandomSource like INSeededRandom.
+ 
+ The sampler is immutable and can be used by many threads at the same time, as long as a passed random source isn't shared between them.
+ 
+    INWeightedSampler *sampler = [INWeightedSampler samplerWithObjects:@[@"A", @"B"] weights:@[@9, @1]];
+    NSString *variant = [sampler randomObject]; // "A" in 90% of the draws
+ */
+@interface INWeightedSampler : NSObject
+
+
+/**
+ The objects to draw from.
+ */
+@property (nonatomic, copy, readonly) NSArray *objects;
+
+
+/**
+ Creates a sampler from objects and their weights.
+ 
+ @param objects The objects to draw from.
+ @param weights The weights as NSNumbers in the same order as the objects, see initWithObjects:weightValues:.
+ @return A new sampler or nil if the weights are not valid.
+ @see initWithObjects:weights:
+ */
++ (instancetype)samplerWithObjects:(NSArray *)objects weights:(NSArray *)weights;
+
+
+/**
+ Initializes a sampler from objects and their weights.
+ 
+ @param objects The objects to draw from.
+ @param weights The weights as NSNumbers in the same order as the objects, see initWithObjects:weightValues:.
+ @return The initialized sampler or nil if the weights are not valid.
+ */
+- (instancetype)initWithObjects:(NSArray *)objects weights:(NSArray *)weights;
+
+
+/**
+ Initializes a sampler from objects and a buffer of their weights.
+ 
+ The weights don't need to be normalized, an object with the weight 2 is drawn twice as often as one with the weight 1.
+ 
+ @param objects The objects to draw from.
+ @param weights A buffer with a weight for each object, all weights have to be finite and not negative and at least one has to be positive.
+ @return The initialized sampler or nil if there are no objects or the weights are not valid.
+ */
+- (instancetype)initWithObjects:(NSArray *)objects weightValues:(const double *)weights;
+
+
+/**
+ Returns the probability of drawing an object.
+ 
+ @param index The index of the object.
+ @return The object's weight divided by the sum of all weights.
+ */
+- (double)probabilityOfObjectAtIndex:(NSUInteger)index;
+
+
+#pragma mark - Drawing objects
+/// @name Drawing objects
+
+/**
+ Draws a random object using arc4random().
+ 
+ @return One of the objects.
+ */
+- (id)randomObject;
+
+
+/**
+ Draws a random object using random numbers from a source.
+ 
+ @param source The source of the random numbers or nil for arc4random().
+ @return One of the objects.
+ */
+- (id)randomObjectUsingRandomSource:(id<INRandomSource>)source;
+
+
+/**
+ Draws the index of a random object using random numbers from a source.
+ 
+ @param source The source of the random numbers or nil for arc4random().
+ @return The index of one of the objects.
+ */
+- (NSUInteger)randomIndexUsingRandomSource:(id<INRandomSource>)source;
+
+
+/**
+ Draws many indexes at once into a buffer.
+ 
+ @param indexes The buffer for the drawn indexes.
+ @param count The number of indexes to draw.
+ @param source The source of the random numbers or nil for arc4random().
+ */
+- (void)getRandomIndexes:(NSUInteger *)indexes count:(NSUInteger)count usingRandomSource:(id<INRandomSource>)source;
+
+
+/**
+ Draws many objects at once.
+ 
+ @param count The number of objects to draw.
+ @param source The source of the random numbers or nil for arc4random().
+ @return An array with the drawn objects, which may contain objects several times.
+ */
+- (NSArray *)randomObjectsWithCount:(NSUInteger)count usingRandomSource:(id<INRandomSource>)source;
+
+
+@end
@@ -0,0 +1,170 @@
+// INWeightedSampler.m
+//
+// Copyright (c) 2014 Sven Korset
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "INWeightedSampler.h"
+#import "INRandom.h"
+
+
+// a probability of 1 scaled to the range of 32 bit random numbers
+static const double INWeightedSamplerScale = 4294967296.0;
+
+
+@implementation INWeightedSampler {
+    // the probability of keeping a drawn column's own index scaled by 2^32, otherwise its alias is taken
+    uint64_t *_thresholds;
+    NSUInteger *_aliases;
+    double *_probabilities;
+    NSUInteger _count;
+}
+
++ (instancetype)samplerWithObjects:(NSArray *)objects weights:(NSArray *)weights {
+    return [[self alloc] initWithObjects:objects weights:weights];
+}
+
+- (instancetype)initWithObjects:(NSArray *)objects weights:(NSArray *)weights {
+    if (weights.count != objects.count) {
+        return nil;
+    }
+    double *weightValues = malloc(MAX(weights.count, 1) * sizeof(double));
+    for (NSUInteger index = 0; index < weights.count; index++) {
+        weightValues[index] = [weights[index] doubleValue];
+    }
+    self = [self initWithObjects:objects weightValues:weightValues];
+    free(weightValues);
+    return self;
+}
+
+- (instancetype)initWithObjects:(NSArray *)objects weightValues:(const double *)weights {
+    self = [super init];
+    if (self == nil) return self;
+
+    _objects = [objects copy];
+    _count = _objects.count;
+    double sum = 0;
+    for (NSUInteger index = 0; index < _count; index++) {
+        if (!(weights[index] >= 0 && isfinite(weights[index]))) {
+            return nil;
+        }
+        sum += weights[index];
+    }
+    if (!(sum > 0 && isfinite(sum))) {
+        return nil;
+    }
+
+    _thresholds = malloc(_count * sizeof(uint64_t));
+    _aliases = malloc(_count * sizeof(NSUInteger));
+    _probabilities = malloc(_count * sizeof(double));
+    double *scaledWeights = malloc(_count * sizeof(double));
+    // the indexes with less and with more than the average weight, small from the front and large from the back
+    NSUInteger *worklist = malloc(_count * sizeof(NSUInteger));
+    NSUInteger smallCount = 0;
+    NSUInteger largeStart = _count;
+    for (NSUInteger index = 0; index < _count; index++) {
+        _probabilities[index] = weights[index] / sum;
+        scaledWeights[index] = _probabilities[index] * _count;
+        _aliases[index] = index;
+        if (scaledWeights[index] < 1) {
+            worklist[smallCount++] = index;
+        } else {
+            worklist[--largeStart] = index;
+        }
+    }
+
+    // Vose's alias method, each small column is filled up with a part of a large one
+    while (smallCount > 0 && largeStart < _count) {
+        NSUInteger small = worklist[--smallCount];
+        NSUInteger large = worklist[largeStart++];
+        _thresholds[small] = (uint64_t)(scaledWeights[small] * INWeightedSamplerScale);
+        _aliases[small] = large;
+        scaledWeights[large] = (scaledWeights[large] + scaledWeights[small]) - 1;
+        if (scaledWeights[large] < 1) {
+            worklist[smallCount++] = large;
+        } else {
+            worklist[--largeStart] = large;
+        }
+    }
+    // the remaining columns are full, small ones only remain due to rounding errors
+    while (largeStart < _count) {
+        _thresholds[worklist[largeStart++]] = (uint64_t)INWeightedSamplerScale;
+    }
+    while (smallCount > 0) {
+        _thresholds[worklist[--smallCount]] = (uint64_t)INWeightedSamplerScale;
+    }
+    free(worklist);
+    free(scaledWeights);
+
+    return self;
+}
+
+- (void)dealloc {
+    free(_thresholds);
+    free(_aliases);
+    free(_probabilities);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p, %lu objects>", NSStringFromClass([self class]), self, (unsigned long)_count];
+}
+
+- (double)probabilityOfObjectAtIndex:(NSUInteger)index {
+    return index < _count ? _probabilities[index] : 0;
+}
+
+
+#pragma mark - Drawing objects
+
+- (id)randomObject {
+    return _objects[[self randomIndexUsingRandomSource:nil]];
+}
+
+- (id)randomObjectUsingRandomSource:(id<INRandomSource>)source {
+    return _objects[[self randomIndexUsingRandomSource:source]];
+}
+
+- (NSUInteger)randomIndexUsingRandomSource:(id<INRandomSource>)source {
+    NSUInteger column = [INRandom integerBelow:_count withRandomSource:source];
+    uint32_t coin = source != nil ? [source randomInteger] : arc4random();
+    return coin < _thresholds[column] ? column : _aliases[column];
+}
+
+- (void)getRandomIndexes:(NSUInteger *)indexes count:(NSUInteger)count usingRandomSource:(id<INRandomSource>)source {
+    for (NSUInteger index = 0; index < count; index++) {
+        indexes[index] = [self randomIndexUsingRandomSource:source];
+    }
+}
+
+- (NSArray *)randomObjectsWithCount:(NSUInteger)count usingRandomSource:(id<INRandomSource>)source {
+    NSUInteger *indexes = malloc(MAX(count, 1) * sizeof(NSUInteger));
+    [self getRandomIndexes:indexes count:count usingRandomSource:source];
+    __unsafe_unretained id *objects = (__unsafe_unretained id *)malloc(MAX(count, 1) * sizeof(id));
+    for (NSUInteger index = 0; index < count; index++) {
+        objects[index] = _objects[indexes[index]];
+    }
+    NSArray *array = [NSArray arrayWithObjects:objects count:count];
+    free(objects);
+    free(indexes);
+    return array;
+}
+
+
+@end